@@ -0,0 +1,559 @@
+// Benchmarks no host das rotinas críticas: compensação do BMP280, conversão
+// do AHT20, formatação/decodificação do payload, envio/recepção LoRa e o
+// quadro seguro (AES-128-CTR + CMAC). Antes deles, verificações de
+// correção, inclusive do log de contadores na flash simulada.
+// Os resultados saem em JSON no stdout para acompanhar regressões.
+//
+// Uso: lora_bench [--iterations N] [--repeats R] [--cpu-mhz F]
+//
+// Os tempos também saem em ciclos: por padrão, na frequência do TSC (x86),
+// calibrada contra o relógio monotônico; --cpu-mhz fixa a frequência usada
+// na conversão (por exemplo, com turbo/escalonamento desligados).
+
+#define _POSIX_C_SOURCE 199309L
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+#include "sim/sim_hw.h"
+#include "hardware/flash.h"
+#include "lora/lora.h"
+#include "aht20/aht20.h"
+#include "bmp280/bmp280.h"
+#include "payload/payload.h"
+#include "secure/secure_frame.h"
+#include "secure/secure_rx.h"
+
+#define MAX_REPEATS 32
+
+// Destino dos resultados, para que o compilador não elimine os laços
+static volatile int32_t sink_i;
+static volatile float sink_f;
+
+static lora_config_t lora_config = {
+    .spi = NULL, // Preenchido em main() (spi0 é um símbolo do simulador)
+    .pin_cs = 17,
+    .pin_rst = 20,
+    .pin_sck = 18,
+    .pin_mosi = 19,
+    .pin_miso = 16
+};
+
+static struct bmp280_calib_param calib;
+static const char sample_payload[] = "T1:25.08,T2:25.00,H:50.00";
+#define SAMPLE_LEN (sizeof(sample_payload) - 1)
+
+static const uint8_t node_key[AES128_BLOCK_SIZE] = {
+    0x2b, 0x7e, 0x15, 0x16, 0x28, 0xae, 0xd2, 0xa6, 0xab, 0xf7, 0x15, 0x88, 0x09, 0xcf, 0x4f, 0x3c
+};
+static secure_node_t tx_node;
+static secure_node_t rx_node;
+static uint8_t sealed_frame[64];
+static int sealed_len;
+
+// Frequência usada para converter ns em ciclos (0 = sem conversão)
+static double cpu_mhz = 0.0;
+static const char *cycles_source = "none";
+
+static uint64_t now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (uint64_t)ts.tv_sec * 1000000000ull + ts.tv_nsec;
+}
+
+// Estima a frequência do TSC medindo-o durante ~50 ms do relógio monotônico
+static double calibrate_tsc_mhz(void) {
+#if defined(__x86_64__) || defined(__i386__)
+    uint64_t start_ns = now_ns();
+    uint64_t start_tsc = __rdtsc();
+    uint64_t elapsed_ns;
+    do {
+        elapsed_ns = now_ns() - start_ns;
+    } while (elapsed_ns < 50000000ull);
+    return (double)(__rdtsc() - start_tsc) * 1000.0 / elapsed_ns;
+#else
+    return 0.0;
+#endif
+}
+
+// ---------------------------------------------------------------------------
+// Corpos dos benchmarks: cada um executa 'iters' operações
+
+static void bench_bmp280_convert_pressure(uint32_t iters) {
+    for (uint32_t i = 0; i < iters; i++) {
+        // Varia a entrada para evitar que o resultado seja constante
+        int32_t raw_press = SIM_BMP280_RAW_PRESS + (int32_t)(i & 0x3FF);
+        int32_t raw_temp = SIM_BMP280_RAW_TEMP + (int32_t)(i & 0xFF);
+        sink_i = bmp280_convert_pressure(raw_press, raw_temp, &calib);
+    }
+}
+
+static void bench_bmp280_convert_temp(uint32_t iters) {
+    for (uint32_t i = 0; i < iters; i++) {
+        sink_i = bmp280_convert_temp(SIM_BMP280_RAW_TEMP + (int32_t)(i & 0x3FF), &calib);
+    }
+}
+
+static void bench_aht20_convert(uint32_t iters) {
+    uint8_t buffer[6] = { 0x1C, 0x80, 0x00, 0x06, 0x00, 0x00 };
+    AHT20_Data data;
+    for (uint32_t i = 0; i < iters; i++) {
+        buffer[2] = (uint8_t)i;
+        buffer[5] = (uint8_t)(i >> 8);
+        aht20_convert(buffer, &data);
+        sink_f = data.temperature + data.humidity;
+    }
+}
+
+static void bench_payload_format(uint32_t iters) {
+    char payload[64];
+    for (uint32_t i = 0; i < iters; i++) {
+        float t = 20.0f + (float)(i & 0xFF) * 0.01f;
+        sink_i = format_data_string(payload, sizeof(payload), t, t + 0.5f, 50.0f);
+    }
+}
+
+static void bench_payload_parse(uint32_t iters) {
+    float temp_bmp, temp_aht, hum_aht;
+    for (uint32_t i = 0; i < iters; i++) {
+        sink_i = parse_data_string(sample_payload, &temp_bmp, &temp_aht, &hum_aht);
+        sink_f = temp_bmp + temp_aht + hum_aht;
+    }
+}
+
+static void bench_lora_send_packet(uint32_t iters) {
+    for (uint32_t i = 0; i < iters; i++) {
+        lora_send_packet(&lora_config, (uint8_t *)sample_payload, sizeof(sample_payload) - 1);
+    }
+}
+
+static void bench_lora_receive_packet(uint32_t iters) {
+    uint8_t buffer[256];
+    uint8_t len;
+    for (uint32_t i = 0; i < iters; i++) {
+        sim_sx1276_inject_packet((const uint8_t *)sample_payload, sizeof(sample_payload) - 1);
+        sink_i = lora_receive_packet(&lora_config, buffer, &len);
+    }
+}
+
+static void bench_aes128_encrypt_block(uint32_t iters) {
+    uint8_t block[AES128_BLOCK_SIZE] = { 0 };
+    for (uint32_t i = 0; i < iters; i++) {
+        aes128_encrypt_block(&tx_node.enc, block, block);
+    }
+    sink_i = block[0];
+}
+
+static void bench_secure_frame_seal(uint32_t iters) {
+    uint8_t frame[64];
+    for (uint32_t i = 0; i < iters; i++) {
+        memcpy(frame + SECURE_FRAME_HEADER_LEN, sample_payload, SAMPLE_LEN);
+        sink_i = secure_frame_seal(&tx_node, frame, SAMPLE_LEN, sizeof(frame));
+    }
+}
+
+static void bench_secure_frame_open(uint32_t iters) {
+    uint8_t frame[64];
+    for (uint32_t i = 0; i < iters; i++) {
+        // Reaproveita o mesmo quadro: zera o anti-replay a cada volta
+        memcpy(frame, sealed_frame, sealed_len);
+        rx_node.counter = 0;
+        sink_i = secure_frame_open(&rx_node, frame, sealed_len);
+    }
+}
+
+// ---------------------------------------------------------------------------
+// Execução e saída
+
+typedef struct {
+    const char *name;
+    void (*fn)(uint32_t iters);
+    uint32_t bytes_per_op;  // > 0: também reporta o custo por byte de payload
+    bool spi;               // Mede o tráfego SPI de uma operação
+} bench_t;
+
+static const bench_t benches[] = {
+    { "bmp280_convert_pressure", bench_bmp280_convert_pressure, 0, false },
+    { "bmp280_convert_temp",     bench_bmp280_convert_temp,     0, false },
+    { "aht20_convert",           bench_aht20_convert,           0, false },
+    { "payload_format",          bench_payload_format,          0, false },
+    { "payload_parse",           bench_payload_parse,           0, false },
+    { "lora_send_packet",        bench_lora_send_packet,        SAMPLE_LEN, true },
+    { "lora_receive_packet",     bench_lora_receive_packet,     SAMPLE_LEN, true },
+    { "aes128_encrypt_block",    bench_aes128_encrypt_block,    AES128_BLOCK_SIZE, false },
+    { "secure_frame_seal",       bench_secure_frame_seal,       SAMPLE_LEN, false },
+    { "secure_frame_open",       bench_secure_frame_open,       SAMPLE_LEN, false },
+};
+
+static int compare_double(const void *a, const void *b) {
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+    return (x > y) - (x < y);
+}
+
+static void run_bench(const bench_t *bench, uint32_t iters, int repeats, bool last) {
+    double samples[MAX_REPEATS];
+
+    bench->fn(iters / 10 + 1); // Aquecimento
+
+    for (int r = 0; r < repeats; r++) {
+        uint64_t start = now_ns();
+        bench->fn(iters);
+        samples[r] = (double)(now_ns() - start) / iters;
+    }
+    qsort(samples, repeats, sizeof(double), compare_double);
+
+    printf("    {\"name\": \"%s\", \"iterations\": %u, \"ns_per_op\": %.2f, \"ns_per_op_min\": %.2f, \"ns_per_op_max\": %.2f",
+           bench->name, iters, samples[repeats / 2], samples[0], samples[repeats - 1]);
+
+    if (bench->bytes_per_op > 0) {
+        printf(", \"payload_bytes\": %u, \"ns_per_byte\": %.3f",
+               bench->bytes_per_op, samples[repeats / 2] / bench->bytes_per_op);
+    }
+
+    if (cpu_mhz > 0.0) {
+        double cycles_per_op = samples[repeats / 2] * cpu_mhz / 1000.0;
+        printf(", \"cycles_per_op\": %.1f", cycles_per_op);
+        if (bench->bytes_per_op > 0) {
+            printf(", \"cycles_per_byte\": %.2f", cycles_per_op / bench->bytes_per_op);
+        }
+    }
+
+    // Tráfego SPI de uma única operação (determinístico no simulador)
+    if (bench->spi) {
+        sim_spi_reset_counters();
+        bench->fn(1);
+        sim_spi_counters_t counters = sim_spi_get_counters();
+        printf(", \"spi_transactions\": %u, \"spi_transactions_per_byte\": %.3f, \"spi_bytes_per_byte\": %.3f",
+               counters.transactions,
+               (double)counters.transactions / bench->bytes_per_op,
+               (double)counters.bytes / bench->bytes_per_op);
+    }
+    printf("}%s\n", last ? "" : ",");
+}
+
+// Confere se as rotinas produzem os valores esperados antes de medir
+// Reserva o próximo contador de cada nó (bloco 1: uma gravação por chamada).
+// Retorna quantas reservas falharam; confirmed guarda os limites aceitos.
+static int reserve_round(uint32_t *limits, uint32_t *confirmed, int nodes) {
+    int failures = 0;
+    for (int n = 0; n < nodes; n++) {
+        if (counter_store_reserve((uint8_t)(n + 1), &limits[n], limits[n] + 1, 1)) {
+            confirmed[n] = limits[n];
+        } else {
+            failures++;
+        }
+    }
+    return failures;
+}
+
+// Log de contadores na flash simulada: compactação, quedas de energia,
+// excesso de nós e a recepção segura após um reboot do receptor
+static bool counter_store_checks(void) {
+    bool ok = true;
+
+    // Flash inicial com lixo e vários ciclos de compactação com dois nós
+    sim_flash_fill(0x00);
+    uint32_t limit_a = 0, limit_b = 0;
+    for (uint32_t c = 1; c <= 20000 && ok; c++) {
+        uint32_t prev_a = limit_a, prev_b = limit_b;
+        if (!counter_store_reserve(1, &limit_a, c, 16) || !counter_store_reserve(2, &limit_b, c / 2 + 1, 4)) {
+            fprintf(stderr, "counter_store: falha ao gravar o contador %u\n", c);
+            ok = false;
+        } else if ((limit_a != prev_a || limit_b != prev_b) &&
+                   (counter_store_load(1) != limit_a || counter_store_load(2) != limit_b)) {
+            fprintf(stderr, "counter_store: limite lido difere do gravado no contador %u\n", c);
+            ok = false;
+        }
+    }
+
+    // Duas quedas de energia seguidas em cada operação ao redor de uma
+    // compactação: após religar, nenhum limite confirmado pode regredir
+    const int nodes = 3;
+    const int records = FLASH_SECTOR_SIZE / 16;
+    for (int loss1 = 0; loss1 < 6 && ok; loss1++) {
+        for (int loss2 = 0; loss2 < 6 && ok; loss2++) {
+            uint32_t limits[3] = { 0 }, confirmed[3] = { 0 };
+            sim_flash_fill(0xFF);
+            while (limits[0] * nodes < (uint32_t)(records - nodes)) {
+                reserve_round(limits, confirmed, nodes);
+            }
+
+            const int losses[2] = { loss1, loss2 };
+            for (int l = 0; l < 2; l++) {
+                sim_flash_power_loss_after(losses[l]);
+                for (int round = 0; round < 3; round++) {
+                    reserve_round(limits, confirmed, nodes);
+                }
+                sim_flash_power_on();
+                // Reboot: os limites voltam a ser lidos da flash
+                for (int n = 0; n < nodes; n++) {
+                    limits[n] = counter_store_load((uint8_t)(n + 1));
+                    if (limits[n] < confirmed[n]) {
+                        fprintf(stderr, "counter_store: no %d regrediu (%u < %u) com quedas em %d/%d\n",
+                                n + 1, limits[n], confirmed[n], loss1, loss2);
+                        ok = false;
+                    }
+                }
+            }
+
+            // Sem novas quedas, o log volta a funcionar por mais duas compactações
+            for (int round = 0; round < 2 * records / nodes && ok; round++) {
+                if (reserve_round(limits, confirmed, nodes) != 0) {
+                    fprintf(stderr, "counter_store: falha após religar com quedas em %d/%d\n", loss1, loss2);
+                    ok = false;
+                }
+            }
+        }
+    }
+
+    // Mais nós do que a compactação comporta: a gravação falha em vez de
+    // descartar o limite de algum nó
+    sim_flash_fill(0xFF);
+    uint32_t many[COUNTER_STORE_MAX_NODES + 1] = { 0 };
+    for (int n = 0; n <= COUNTER_STORE_MAX_NODES; n++) {
+        counter_store_reserve((uint8_t)(n + 1), &many[n], 1, 1);
+    }
+    bool refused = false;
+    for (int i = 0; i < records && !refused; i++) {
+        refused = !counter_store_reserve(1, &many[0], many[0] + 1, 1);
+    }
+    for (int n = 1; n <= COUNTER_STORE_MAX_NODES; n++) {
+        refused = refused && counter_store_load((uint8_t)(n + 1)) == 1;
+    }
+    if (!refused) {
+        fprintf(stderr, "counter_store: excesso de nós não foi recusado\n");
+        ok = false;
+    }
+
+    // Recepção segura: replay rejeitado após o reboot do receptor, quadros
+    // acima do limite gravado aceitos e falha de gravação sem entrega
+    static secure_rx_t rx;
+    secure_node_t tx;
+    uint8_t frame[64], first[64];
+    sim_flash_fill(0xFF);
+    secure_rx_init(&rx);
+    secure_rx_add_node(&rx, 1, node_key);
+    secure_node_init(&tx, 1, node_key, 0);
+
+    memcpy(frame + SECURE_FRAME_HEADER_LEN, sample_payload, SAMPLE_LEN);
+    int len = secure_frame_seal(&tx, frame, SAMPLE_LEN, sizeof(frame));
+    memcpy(first, frame, len);
+    const secure_node_t *node = NULL;
+    if (secure_rx_accept(&rx, frame, len, &node) != (int)SAMPLE_LEN || node == NULL ||
+        strcmp((char *)frame + SECURE_FRAME_HEADER_LEN, sample_payload) != 0) {
+        fprintf(stderr, "secure_rx: quadro válido rejeitado\n");
+        ok = false;
+    }
+
+    secure_rx_init(&rx);
+    secure_rx_add_node(&rx, 1, node_key);
+    if (secure_rx_accept(&rx, first, len, NULL) != SECURE_FRAME_ERR_REPLAY) {
+        fprintf(stderr, "secure_rx: replay aceito após o reboot\n");
+        ok = false;
+    }
+    tx.counter = SECURE_COUNTER_RX_BLOCK;
+    memcpy(frame + SECURE_FRAME_HEADER_LEN, sample_payload, SAMPLE_LEN);
+    len = secure_frame_seal(&tx, frame, SAMPLE_LEN, sizeof(frame));
+    if (secure_rx_accept(&rx, frame, len, NULL) != (int)SAMPLE_LEN) {
+        fprintf(stderr, "secure_rx: quadro acima do limite rejeitado após o reboot\n");
+        ok = false;
+    }
+
+    tx.counter = 1000;
+    memcpy(frame + SECURE_FRAME_HEADER_LEN, sample_payload, SAMPLE_LEN);
+    len = secure_frame_seal(&tx, frame, SAMPLE_LEN, sizeof(frame));
+    sim_flash_power_loss_after(0);
+    if (secure_rx_accept(&rx, frame, len, NULL) != SECURE_RX_ERR_STORE) {
+        fprintf(stderr, "secure_rx: quadro entregue sem gravar o contador\n");
+        ok = false;
+    }
+    sim_flash_power_on();
+
+    return ok;
+}
+
+static bool sanity_checks(void) {
+    bool ok = true;
+
+    // Exemplo do datasheet: 25,08 °C e ~100653 Pa
+    int32_t temp = bmp280_convert_temp(SIM_BMP280_RAW_TEMP, &calib);
+    int32_t press = bmp280_convert_pressure(SIM_BMP280_RAW_PRESS, SIM_BMP280_RAW_TEMP, &calib);
+    if (temp != 2508 || press < 100640 || press > 100665) {
+        fprintf(stderr, "bmp280: temp=%d press=%d fora do esperado\n", temp, press);
+        ok = false;
+    }
+
+    AHT20_Data data;
+    if (!aht20_read(i2c1, &data) || data.temperature != 25.0f || data.humidity != 50.0f) {
+        fprintf(stderr, "aht20: leitura fora do esperado\n");
+        ok = false;
+    }
+
+    float t1, t2, h;
+    if (!parse_data_string(sample_payload, &t1, &t2, &h) || t1 != 25.08f || h != 50.0f) {
+        fprintf(stderr, "payload: decodificação fora do esperado\n");
+        ok = false;
+    }
+
+    uint8_t len;
+    lora_send_packet(&lora_config, (uint8_t *)sample_payload, sizeof(sample_payload) - 1);
+    const uint8_t *sent = sim_sx1276_last_tx(&len);
+    if (len != sizeof(sample_payload) - 1 || memcmp(sent, sample_payload, len) != 0) {
+        fprintf(stderr, "lora: pacote transmitido difere do payload\n");
+        ok = false;
+    }
+
+    uint8_t buffer[256];
+    sim_sx1276_inject_packet((const uint8_t *)sample_payload, sizeof(sample_payload) - 1);
+    if (!lora_receive_packet(&lora_config, buffer, &len) || strcmp((char *)buffer, sample_payload) != 0) {
+        fprintf(stderr, "lora: pacote recebido difere do injetado\n");
+        ok = false;
+    }
+
+    // Vetores conhecidos: FIPS-197 C.1, SP 800-38A F.5.1 e RFC 4493
+    static const uint8_t fips_key[16] = {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f
+    };
+    static const uint8_t fips_pt[16] = {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77, 0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff
+    };
+    static const uint8_t fips_ct[16] = {
+        0x69, 0xc4, 0xe0, 0xd8, 0x6a, 0x7b, 0x04, 0x30, 0xd8, 0xcd, 0xb7, 0x80, 0x70, 0xb4, 0xc5, 0x5a
+    };
+    static const uint8_t nist_msg[16] = {
+        0x6b, 0xc1, 0xbe, 0xe2, 0x2e, 0x40, 0x9f, 0x96, 0xe9, 0x3d, 0x7e, 0x11, 0x73, 0x93, 0x17, 0x2a
+    };
+    static const uint8_t ctr_ct[16] = {
+        0x87, 0x4d, 0x61, 0x91, 0xb6, 0x20, 0xe3, 0x26, 0x1b, 0xef, 0x68, 0x64, 0x99, 0x0d, 0xb6, 0xce
+    };
+    static const uint8_t cmac_tag[16] = {
+        0x07, 0x0a, 0x16, 0xb4, 0x6b, 0x4d, 0x41, 0x44, 0xf7, 0x9b, 0xdd, 0x9d, 0xd0, 0x4a, 0x28, 0x7c
+    };
+    static const uint8_t cmac_empty_tag[16] = {
+        0xbb, 0x1d, 0x69, 0x29, 0xe9, 0x59, 0x37, 0x28, 0x7f, 0xa3, 0x7d, 0x12, 0x9b, 0x75, 0x67, 0x46
+    };
+
+    aes128_ctx_t aes;
+    uint8_t out[16];
+    aes128_init(&aes, fips_key);
+    aes128_encrypt_block(&aes, fips_pt, out);
+    if (memcmp(out, fips_ct, 16) != 0) {
+        fprintf(stderr, "aes128: vetor FIPS-197 falhou\n");
+        ok = false;
+    }
+
+    uint8_t counter[16];
+    for (int i = 0; i < 16; i++) {
+        counter[i] = 0xf0 + i;
+    }
+    memcpy(out, nist_msg, 16);
+    aes128_init(&aes, node_key);
+    aes128_ctr_xor(&aes, counter, out, 16);
+    if (memcmp(out, ctr_ct, 16) != 0) {
+        fprintf(stderr, "aes128: vetor CTR falhou\n");
+        ok = false;
+    }
+
+    aes128_cmac_ctx_t cmac;
+    aes128_cmac_init(&cmac, node_key);
+    aes128_cmac(&cmac, nist_msg, 16, out);
+    if (memcmp(out, cmac_tag, 16) != 0) {
+        fprintf(stderr, "aes128: vetor CMAC falhou\n");
+        ok = false;
+    }
+    aes128_cmac(&cmac, NULL, 0, out);
+    if (memcmp(out, cmac_empty_tag, 16) != 0) {
+        fprintf(stderr, "aes128: vetor CMAC (vazio) falhou\n");
+        ok = false;
+    }
+
+    // Quadro seguro: ida e volta, replay e adulteração
+    uint8_t frame[64];
+    memcpy(frame + SECURE_FRAME_HEADER_LEN, sample_payload, SAMPLE_LEN);
+    sealed_len = secure_frame_seal(&tx_node, frame, SAMPLE_LEN, sizeof(frame));
+    memcpy(sealed_frame, frame, sealed_len);
+    if (secure_frame_open(&rx_node, frame, sealed_len) != (int)SAMPLE_LEN ||
+        memcmp(frame + SECURE_FRAME_HEADER_LEN, sample_payload, SAMPLE_LEN) != 0) {
+        fprintf(stderr, "secure_frame: ida e volta falhou\n");
+        ok = false;
+    }
+    memcpy(frame, sealed_frame, sealed_len);
+    if (secure_frame_open(&rx_node, frame, sealed_len) != SECURE_FRAME_ERR_REPLAY) {
+        fprintf(stderr, "secure_frame: replay não detectado\n");
+        ok = false;
+    }
+    memcpy(frame, sealed_frame, sealed_len);
+    frame[SECURE_FRAME_HEADER_LEN] ^= 0x01;
+    rx_node.counter = 0;
+    if (secure_frame_open(&rx_node, frame, sealed_len) != SECURE_FRAME_ERR_AUTH) {
+        fprintf(stderr, "secure_frame: adulteração não detectada\n");
+        ok = false;
+    }
+
+    return ok && counter_store_checks();
+}
+
+int main(int argc, char **argv) {
+    uint32_t iters = 200000;
+    int repeats = 7;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--iterations") == 0 && i + 1 < argc) {
+            iters = (uint32_t)strtoul(argv[++i], NULL, 10);
+        } else if (strcmp(argv[i], "--repeats") == 0 && i + 1 < argc) {
+            repeats = atoi(argv[++i]);
+        } else if (strcmp(argv[i], "--cpu-mhz") == 0 && i + 1 < argc) {
+            cpu_mhz = strtod(argv[++i], NULL);
+            cycles_source = "cpu_mhz";
+        } else {
+            fprintf(stderr, "uso: %s [--iterations N] [--repeats R] [--cpu-mhz F]\n", argv[0]);
+            return 2;
+        }
+    }
+    if (iters == 0) {
+        iters = 1;
+    }
+    if (repeats < 1 || repeats > MAX_REPEATS) {
+        repeats = repeats < 1 ? 1 : MAX_REPEATS;
+    }
+    if (cpu_mhz <= 0.0) {
+        cpu_mhz = calibrate_tsc_mhz();
+        cycles_source = cpu_mhz > 0.0 ? "tsc" : "none";
+    }
+
+    // Hardware simulado: rádio em spi0, BMP280 em i2c0 e AHT20 em i2c1
+    lora_config.spi = spi0;
+    sim_sx1276_reset(lora_config.pin_cs);
+    lora_setup(&lora_config);
+
+    i2c_async_init(i2c0);
+    i2c_async_init(i2c1);
+    bmp280_init(i2c0);
+    if (!bmp280_get_calib_params(i2c0, &calib)) {
+        fprintf(stderr, "falha ao ler a calibracao do BMP280 simulado\n");
+        return 1;
+    }
+    aht20_init(i2c1);
+
+    secure_node_init(&tx_node, 1, node_key, 0);
+    secure_node_init(&rx_node, 1, node_key, 0);
+
+    if (!sanity_checks()) {
+        return 1;
+    }
+
+    size_t count = sizeof(benches) / sizeof(benches[0]);
+    printf("{\n  \"suite\": \"lora_bench\",\n  \"repeats\": %d,\n", repeats);
+    printf("  \"cycles_source\": \"%s\",\n  \"cpu_mhz\": %.1f,\n  \"results\": [\n", cycles_source, cpu_mhz);
+    for (size_t i = 0; i < count; i++) {
+        run_bench(&benches[i], iters, repeats, i + 1 == count);
+    }
+    printf("  ]\n}\n");
+
+    return 0;
+}
@@ -0,0 +1,15 @@
+#ifndef SIM_HARDWARE_I2C_H
+#define SIM_HARDWARE_I2C_H
+
+#include "pico.h"
+
+typedef struct i2c_inst i2c_inst_t;
+
+extern i2c_inst_t *const sim_i2c0;
+extern i2c_inst_t *const sim_i2c1;
+#define i2c0 sim_i2c0
+#define i2c1 sim_i2c1
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate);
+
+#endif
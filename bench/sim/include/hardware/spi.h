@@ -0,0 +1,17 @@
+#ifndef SIM_HARDWARE_SPI_H
+#define SIM_HARDWARE_SPI_H
+
+#include "pico.h"
+
+typedef struct spi_inst spi_inst_t;
+
+extern spi_inst_t *const sim_spi0;
+extern spi_inst_t *const sim_spi1;
+#define spi0 sim_spi0
+#define spi1 sim_spi1
+
+uint spi_init(spi_inst_t *spi, uint baudrate);
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len);
+int spi_read_blocking(spi_inst_t *spi, uint8_t repeated_tx_data, uint8_t *dst, size_t len);
+
+#endif
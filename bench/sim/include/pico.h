@@ -0,0 +1,16 @@
+// Substituto mínimo do pico.h do SDK para compilar as bibliotecas no host
+#ifndef SIM_PICO_H
+#define SIM_PICO_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+typedef unsigned int uint;
+
+#define _u(x) x ## u
+
+// Flash de 2 MB, como na placa pico_w
+#define PICO_FLASH_SIZE_BYTES (2 * 1024 * 1024)
+
+#endif
@@ -0,0 +1,14 @@
+// Substituto do pico/stdlib.h: tempo e GPIO simulados (ver sim_hw.c)
+#ifndef SIM_PICO_STDLIB_H
+#define SIM_PICO_STDLIB_H
+
+#include "pico.h"
+#include "hardware/gpio.h"
+
+void sleep_ms(uint32_t ms);
+void sleep_us(uint64_t us);
+uint64_t time_us_64(void);
+
+static inline void tight_loop_contents(void) {}
+
+#endif
@@ -0,0 +1,59 @@
+// Flash simulada: um vetor do host visto pela "XIP" (hardware/regs/addressmap.h).
+// Como na NOR real, apagar leva os bytes a 0xFF e gravar só limpa bits.
+#include <string.h>
+#include "sim_hw.h"
+#include "hardware/flash.h"
+#include "hardware/regs/addressmap.h"
+
+uint8_t sim_flash[PICO_FLASH_SIZE_BYTES];
+
+static int ops_until_loss = -1;    // -1 = sem queda programada
+static bool powered = true;
+
+void sim_flash_fill(uint8_t value) {
+    memset(sim_flash, value, sizeof(sim_flash));
+    sim_flash_power_on();
+}
+
+void sim_flash_power_loss_after(int ops) {
+    ops_until_loss = ops;
+}
+
+void sim_flash_power_on(void) {
+    ops_until_loss = -1;
+    powered = true;
+}
+
+// Retorna quantos dos count passos da operação chegam a ser aplicados
+static size_t op_steps(size_t count) {
+    if (!powered) {
+        return 0;
+    }
+    if (ops_until_loss == 0) {
+        powered = false;
+        return count / 2;
+    }
+    if (ops_until_loss > 0) {
+        ops_until_loss--;
+    }
+    return count;
+}
+
+void flash_range_erase(uint32_t flash_offs, size_t count) {
+    memset(&sim_flash[flash_offs], 0xFF, op_steps(count));
+}
+
+void flash_range_program(uint32_t flash_offs, const uint8_t *data, size_t count) {
+    // Uma gravação interrompida aplica só metade dos bytes que mudam
+    size_t changes = 0;
+    for (size_t i = 0; i < count; i++) {
+        changes += data[i] != 0xFF;
+    }
+    size_t steps = op_steps(changes);
+    for (size_t i = 0; i < count && steps > 0; i++) {
+        if (data[i] != 0xFF) {
+            sim_flash[flash_offs + i] &= data[i];
+            steps--;
+        }
+    }
+}
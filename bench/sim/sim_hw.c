@@ -0,0 +1,174 @@
+#include <string.h>
+#include "sim_hw.h"
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "hardware/i2c.h"
+#include "lora/lora.h"
+
+struct spi_inst { int index; };
+struct i2c_inst { int index; };
+
+static struct spi_inst spi_insts[2] = { { 0 }, { 1 } };
+static struct i2c_inst i2c_insts[2] = { { 0 }, { 1 } };
+spi_inst_t *const sim_spi0 = &spi_insts[0];
+spi_inst_t *const sim_spi1 = &spi_insts[1];
+i2c_inst_t *const sim_i2c0 = &i2c_insts[0];
+i2c_inst_t *const sim_i2c1 = &i2c_insts[1];
+
+// Relógio virtual: sleep_ms() apenas avança o tempo simulado
+static uint64_t virtual_time_us = 0;
+
+void sleep_ms(uint32_t ms) {
+    virtual_time_us += (uint64_t)ms * 1000;
+}
+
+void sleep_us(uint64_t us) {
+    virtual_time_us += us;
+}
+
+uint64_t time_us_64(void) {
+    return virtual_time_us;
+}
+
+// Modelo do SX1276
+static struct {
+    uint8_t regs[128];
+    uint8_t fifo[256];
+    uint8_t last_tx[256];
+    uint8_t last_tx_len;
+    uint pin_cs;
+    bool selected;
+    bool first_byte;
+    bool write;
+    uint8_t addr;
+} radio;
+
+static sim_spi_counters_t spi_counters;
+
+void sim_sx1276_reset(uint pin_cs) {
+    memset(&radio, 0, sizeof(radio));
+    radio.pin_cs = pin_cs;
+}
+
+void sim_sx1276_inject_packet(const uint8_t *data, uint8_t len) {
+    uint8_t base = radio.regs[REG_FIFO_RX_BASE_AD];
+    for (int i = 0; i < len; i++) {
+        radio.fifo[(uint8_t)(base + i)] = data[i];
+    }
+    radio.regs[REG_FIFO_RX_CURRENT_ADDR] = base;
+    radio.regs[REG_RX_NB_BYTES] = len;
+    radio.regs[REG_IRQ_FLAGS] |= 0x40; // RxDone
+}
+
+const uint8_t *sim_sx1276_last_tx(uint8_t *len) {
+    *len = radio.last_tx_len;
+    return radio.last_tx;
+}
+
+void sim_spi_reset_counters(void) {
+    memset(&spi_counters, 0, sizeof(spi_counters));
+}
+
+sim_spi_counters_t sim_spi_get_counters(void) {
+    return spi_counters;
+}
+
+static void reg_write(uint8_t addr, uint8_t value) {
+    switch (addr) {
+    case REG_FIFO:
+        radio.fifo[radio.regs[REG_FIFO_ADDR_PTR]++] = value;
+        break;
+    case REG_IRQ_FLAGS:
+        // Escrever 1 limpa a flag
+        radio.regs[REG_IRQ_FLAGS] &= ~value;
+        break;
+    case REG_OPMODE:
+        radio.regs[REG_OPMODE] = value;
+        if (value == RF95_MODE_TX) {
+            uint8_t base = radio.regs[REG_FIFO_TX_BASE_AD];
+            radio.last_tx_len = radio.regs[REG_PAYLOAD_LENGTH];
+            for (int i = 0; i < radio.last_tx_len; i++) {
+                radio.last_tx[i] = radio.fifo[(uint8_t)(base + i)];
+            }
+            radio.regs[REG_IRQ_FLAGS] |= 0x08; // TxDone imediato
+        }
+        break;
+    default:
+        radio.regs[addr] = value;
+        break;
+    }
+}
+
+static uint8_t reg_read(uint8_t addr) {
+    if (addr == REG_FIFO) {
+        return radio.fifo[radio.regs[REG_FIFO_ADDR_PTR]++];
+    }
+    return radio.regs[addr];
+}
+
+// Acesso em rajada: o endereço avança, exceto na FIFO
+static void next_addr(void) {
+    if (radio.addr != REG_FIFO) {
+        radio.addr = (radio.addr + 1) & 0x7F;
+    }
+}
+
+void gpio_init(uint gpio) { (void)gpio; }
+void gpio_set_dir(uint gpio, bool out) { (void)gpio; (void)out; }
+void gpio_set_function(uint gpio, enum gpio_function fn) { (void)gpio; (void)fn; }
+void gpio_pull_up(uint gpio) { (void)gpio; }
+
+void gpio_put(uint gpio, bool value) {
+    if (gpio != radio.pin_cs) {
+        return;
+    }
+    if (!value && !radio.selected) {
+        spi_counters.transactions++;
+        radio.first_byte = true;
+    }
+    radio.selected = !value;
+}
+
+uint spi_init(spi_inst_t *spi, uint baudrate) {
+    (void)spi;
+    return baudrate;
+}
+
+int spi_write_blocking(spi_inst_t *spi, const uint8_t *src, size_t len) {
+    (void)spi;
+    spi_counters.bytes += len;
+    if (!radio.selected) {
+        return (int)len;
+    }
+    for (size_t i = 0; i < len; i++) {
+        if (radio.first_byte) {
+            radio.addr = src[i] & 0x7F;
+            radio.write = (src[i] & 0x80) != 0;
+            radio.first_byte = false;
+        } else if (radio.write) {
+            reg_write(radio.addr, src[i]);
+            next_addr();
+        }
+    }
+    return (int)len;
+}
+
+int spi_read_blocking(spi_inst_t *spi, uint8_t repeated_tx_data, uint8_t *dst, size_t len) {
+    (void)spi;
+    (void)repeated_tx_data;
+    spi_counters.bytes += len;
+    for (size_t i = 0; i < len; i++) {
+        if (radio.selected && !radio.first_byte && !radio.write) {
+            dst[i] = reg_read(radio.addr);
+            next_addr();
+        } else {
+            dst[i] = 0;
+        }
+    }
+    return (int)len;
+}
+
+uint i2c_init(i2c_inst_t *i2c, uint baudrate) {
+    (void)i2c;
+    return baudrate;
+}
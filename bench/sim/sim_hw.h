@@ -0,0 +1,46 @@
+// sim_hw.h
+/* Hardware simulado para os benchmarks no host: GPIO, SPI com um modelo
+ * do SX1276 (registradores + FIFO), relógio virtual para sleep_ms() e
+ * flash com simulação de queda de energia.
+ */
+
+#ifndef SIM_HW_H
+#define SIM_HW_H
+
+#include "pico.h"
+
+// Contadores de tráfego SPI (uma transação = um ciclo de CS em nível baixo)
+typedef struct {
+    uint32_t transactions;
+    uint32_t bytes;
+} sim_spi_counters_t;
+
+// Reinicia o modelo do SX1276 e associa o pino de CS usado pelo driver
+void sim_sx1276_reset(uint pin_cs);
+
+// Coloca um pacote na FIFO e sinaliza RxDone, como se tivesse chegado pelo ar
+void sim_sx1276_inject_packet(const uint8_t *data, uint8_t len);
+
+// Último pacote transmitido (copiado da FIFO ao entrar em modo TX)
+const uint8_t *sim_sx1276_last_tx(uint8_t *len);
+
+void sim_spi_reset_counters(void);
+sim_spi_counters_t sim_spi_get_counters(void);
+
+// Preenche toda a flash simulada (0xFF = apagada) e religa a alimentação
+void sim_flash_fill(uint8_t value);
+
+// Queda de energia: as próximas ops operações de apagamento/gravação são
+// executadas; a seguinte é interrompida na metade e as demais são ignoradas
+// até sim_flash_power_on()
+void sim_flash_power_loss_after(int ops);
+void sim_flash_power_on(void);
+
+// Valores brutos fornecidos pelos sensores simulados (exemplo do datasheet
+// do BMP280 e 25 °C / 50 % no AHT20)
+#define SIM_BMP280_RAW_TEMP     519888
+#define SIM_BMP280_RAW_PRESS    415148
+#define SIM_AHT20_RAW_HUM       524288
+#define SIM_AHT20_RAW_TEMP      393216
+
+#endif
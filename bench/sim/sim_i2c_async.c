@@ -0,0 +1,140 @@
+// Implementação síncrona da camada i2c_async para o host.
+// As transações são atendidas na hora por modelos do BMP280 e do AHT20.
+#include <string.h>
+#include "sim_hw.h"
+#include "pico/stdlib.h"
+#include "i2c_async/i2c_async.h"
+
+#define SIM_BMP280_ADDR 0x76
+#define SIM_AHT20_ADDR  0x38
+
+static i2c_async_stats_t stats;
+static uint8_t bmp280_regs[256];
+static uint8_t bmp280_ptr;
+static bool models_ready = false;
+
+static void put_raw20(uint8_t *dst, int32_t raw) {
+    dst[0] = (raw >> 12) & 0xFF;
+    dst[1] = (raw >> 4) & 0xFF;
+    dst[2] = (raw & 0x0F) << 4;
+}
+
+static void init_models(void) {
+    // Parâmetros de calibração do exemplo do datasheet do BMP280
+    const uint16_t calib[12] = {
+        27504, 26435, (uint16_t)-1000,
+        36477, (uint16_t)-10685, 3024, 2855, 140, (uint16_t)-7, 15500, (uint16_t)-14600, 6000
+    };
+    for (int i = 0; i < 12; i++) {
+        bmp280_regs[0x88 + 2 * i] = calib[i] & 0xFF;
+        bmp280_regs[0x89 + 2 * i] = calib[i] >> 8;
+    }
+    put_raw20(&bmp280_regs[0xF7], SIM_BMP280_RAW_PRESS);
+    put_raw20(&bmp280_regs[0xFA], SIM_BMP280_RAW_TEMP);
+    models_ready = true;
+}
+
+static bool bmp280_xfer(const uint8_t *src, size_t tx_len, uint8_t *dst, size_t rx_len) {
+    if (tx_len > 0) {
+        bmp280_ptr = src[0];
+        for (size_t i = 1; i < tx_len; i++) {
+            if (bmp280_ptr < 0xF7) {
+                bmp280_regs[bmp280_ptr] = src[i];
+            }
+            bmp280_ptr++;
+        }
+    }
+    for (size_t i = 0; i < rx_len; i++) {
+        dst[i] = bmp280_regs[bmp280_ptr++];
+    }
+    return true;
+}
+
+static bool aht20_xfer(uint8_t *dst, size_t rx_len) {
+    uint8_t data[6];
+    data[0] = 0x1C; // Calibrado, não ocupado
+    data[1] = (SIM_AHT20_RAW_HUM >> 12) & 0xFF;
+    data[2] = (SIM_AHT20_RAW_HUM >> 4) & 0xFF;
+    data[3] = ((SIM_AHT20_RAW_HUM & 0x0F) << 4) | ((SIM_AHT20_RAW_TEMP >> 16) & 0x0F);
+    data[4] = (SIM_AHT20_RAW_TEMP >> 8) & 0xFF;
+    data[5] = SIM_AHT20_RAW_TEMP & 0xFF;
+    for (size_t i = 0; i < rx_len; i++) {
+        dst[i] = i < sizeof(data) ? data[i] : 0;
+    }
+    return true;
+}
+
+void i2c_async_init(i2c_inst_t *i2c) {
+    (void)i2c;
+    if (!models_ready) {
+        init_models();
+    }
+}
+
+bool i2c_async_start(i2c_async_xfer_t *xfer, i2c_inst_t *i2c, uint8_t addr,
+                     const uint8_t *src, size_t tx_len,
+                     uint8_t *dst, size_t rx_len,
+                     i2c_async_callback_t callback, void *user_data) {
+    xfer->done = true;
+    xfer->ok = false;
+
+    size_t total = tx_len + rx_len;
+    if (total == 0 || total > I2C_ASYNC_MAX_LEN) {
+        return false;
+    }
+    if (!models_ready) {
+        init_models();
+    }
+
+    xfer->i2c = i2c;
+    xfer->addr = addr;
+    xfer->dst = dst;
+    xfer->tx_len = tx_len;
+    xfer->rx_len = rx_len;
+    xfer->callback = callback;
+    xfer->user_data = user_data;
+    xfer->t_start = xfer->t_end = time_us_64();
+
+    if (addr == SIM_BMP280_ADDR) {
+        xfer->ok = bmp280_xfer(src, tx_len, dst, rx_len);
+    } else if (addr == SIM_AHT20_ADDR) {
+        xfer->ok = aht20_xfer(dst, rx_len);
+    }
+
+    int bus = (i2c == i2c1) ? 1 : 0;
+    if (xfer->ok) {
+        stats.transfers[bus]++;
+    } else {
+        stats.errors[bus]++;
+    }
+
+    if (callback) {
+        callback(xfer, user_data);
+    }
+    return true;
+}
+
+bool i2c_async_busy(i2c_inst_t *i2c) {
+    (void)i2c;
+    return false;
+}
+
+bool i2c_async_wait(i2c_async_xfer_t *xfer) {
+    return xfer->ok;
+}
+
+bool i2c_async_transfer_blocking(i2c_inst_t *i2c, uint8_t addr,
+                                 const uint8_t *src, size_t tx_len,
+                                 uint8_t *dst, size_t rx_len) {
+    i2c_async_xfer_t xfer;
+    i2c_async_start(&xfer, i2c, addr, src, tx_len, dst, rx_len, NULL, NULL);
+    return xfer.ok;
+}
+
+void i2c_async_get_stats(i2c_async_stats_t *out) {
+    *out = stats;
+}
+
+void i2c_async_reset_stats(void) {
+    memset(&stats, 0, sizeof(stats));
+}
@@ -12,13 +12,13 @@
 
 bool aht20_init(i2c_inst_t *i2c) {
     uint8_t init_cmd[3] = {AHT20_CMD_INIT, 0x08, 0x00};
-    i2c_write_blocking(i2c, AHT20_I2C_ADDR, init_cmd, 3, false);
+    i2c_async_transfer_blocking(i2c, AHT20_I2C_ADDR, init_cmd, 3, NULL, 0);
     sleep_ms(50);  // Aguarda o sensor inicializar
 
     // Verifica status até que o sensor esteja pronto
-    uint8_t status;
+    uint8_t status = 0;
     for (int i = 0; i < 10; i++) {
-        i2c_read_blocking(i2c, AHT20_I2C_ADDR, &status, 1, false);
+        i2c_async_transfer_blocking(i2c, AHT20_I2C_ADDR, NULL, 0, &status, 1);
         if ((status & AHT20_STATUS_CALIBRATED) == AHT20_STATUS_CALIBRATED) {
             return true;  // Sensor calibrado e pronto
         }
@@ -33,12 +33,12 @@ bool aht20_read(i2c_inst_t *i2c, AHT20_Data *data) {
     uint8_t buffer[6];
 
     // Envia comando de medição
-    i2c_write_blocking(i2c, AHT20_I2C_ADDR, trigger_cmd, 3, false);
+    i2c_async_transfer_blocking(i2c, AHT20_I2C_ADDR, trigger_cmd, 3, NULL, 0);
     
     // Aguarda até o sensor estar pronto
-    uint8_t status;
+    uint8_t status = AHT20_STATUS_BUSY;
     for (int i = 0; i < 10; i++) {
-        i2c_read_blocking(i2c, AHT20_I2C_ADDR, &status, 1, false);
+        i2c_async_transfer_blocking(i2c, AHT20_I2C_ADDR, NULL, 0, &status, 1);
         if (!(status & AHT20_STATUS_BUSY)) {
             break;
         }
@@ -51,10 +51,15 @@ bool aht20_read(i2c_inst_t *i2c, AHT20_Data *data) {
     }
 
     // Lê os 6 bytes de dados
-    if (i2c_read_blocking(i2c, AHT20_I2C_ADDR, buffer, 6, false) != 6) {
+    if (!i2c_async_transfer_blocking(i2c, AHT20_I2C_ADDR, NULL, 0, buffer, 6)) {
         return false;
     }
 
+    aht20_convert(buffer, data);
+    return true;
+}
+
+void aht20_convert(const uint8_t *buffer, AHT20_Data *data) {
     // Processa os dados de umidade (20 bits)
     uint32_t raw_humidity = ((uint32_t)buffer[1] << 12) | ((uint32_t)buffer[2] << 4) | (buffer[3] >> 4);
     data->humidity = (float)raw_humidity * 100.0 / 1048576.0;
@@ -62,18 +67,42 @@ bool aht20_read(i2c_inst_t *i2c, AHT20_Data *data) {
     // Processa os dados de temperatura (20 bits)
     uint32_t raw_temp = ((uint32_t)(buffer[3] & 0x0F) << 16) | ((uint32_t)buffer[4] << 8) | buffer[5];
     data->temperature = ((float)raw_temp * 200.0 / 1048576.0) - 50.0;
+}
+
+bool aht20_trigger_start(i2c_inst_t *i2c, aht20_async_t *ctx, i2c_async_callback_t callback, void *user_data) {
+    ctx->cmd[0] = AHT20_CMD_TRIGGER;
+    ctx->cmd[1] = 0x33;
+    ctx->cmd[2] = 0x00;
+    return i2c_async_start(&ctx->xfer, i2c, AHT20_I2C_ADDR, ctx->cmd, 3, NULL, 0, callback, user_data);
+}
+
+bool aht20_fetch_start(i2c_inst_t *i2c, aht20_async_t *ctx, i2c_async_callback_t callback, void *user_data) {
+    // O primeiro byte lido é o status; os 5 seguintes, as medições
+    return i2c_async_start(&ctx->xfer, i2c, AHT20_I2C_ADDR, NULL, 0, ctx->buf, 6, callback, user_data);
+}
+
+bool aht20_fetch_finish(aht20_async_t *ctx, AHT20_Data *data) {
+    if (!i2c_async_wait(&ctx->xfer)) {
+        return false;
+    }
+
+    // Medição ainda em andamento: resultado inválido
+    if (ctx->buf[0] & AHT20_STATUS_BUSY) {
+        return false;
+    }
 
+    aht20_convert(ctx->buf, data);
     return true;
 }
 
 void aht20_reset(i2c_inst_t *i2c) {
     uint8_t reset_cmd = AHT20_CMD_RESET;
-    i2c_write_blocking(i2c, AHT20_I2C_ADDR, &reset_cmd, 1, false);
+    i2c_async_transfer_blocking(i2c, AHT20_I2C_ADDR, &reset_cmd, 1, NULL, 0);
     sleep_ms(20);
     aht20_init(i2c);
 }
 
 bool aht20_check(i2c_inst_t *i2c) {
     uint8_t status;
-    return i2c_read_blocking(i2c, AHT20_I2C_ADDR, &status, 1, false) == 1;
+    return i2c_async_transfer_blocking(i2c, AHT20_I2C_ADDR, NULL, 0, &status, 1);
 }
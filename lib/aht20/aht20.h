@@ -1,6 +1,7 @@
 #ifndef AHT20_H
 #define AHT20_H
 
+#include "../i2c_async/i2c_async.h"
 
 // Endereço I2C do AHT20
 #define AHT20_I2C_ADDR  0x38
@@ -16,6 +17,16 @@ typedef struct {
     float humidity;
 } AHT20_Data;
 
+// Contexto de uma transação assíncrona (via DMA) com o AHT20
+typedef struct {
+    i2c_async_xfer_t xfer;
+    uint8_t cmd[3];
+    uint8_t buf[6];
+} aht20_async_t;
+
+// Tempo de medição após o comando de disparo (datasheet: 80 ms)
+#define AHT20_MEASURE_TIME_MS   80
+
 // Inicializa o sensor AHT20
 bool aht20_init(i2c_inst_t *i2c);
 
@@ -27,4 +38,14 @@ void aht20_reset(i2c_inst_t *i2c);
 
 bool aht20_check(i2c_inst_t *i2c);
 
+// Converte os 6 bytes brutos (status + umidade + temperatura) em grandezas físicas
+void aht20_convert(const uint8_t *buffer, AHT20_Data *data);
+
+// Versões assíncronas: aht20_trigger_start dispara a medição; após
+// AHT20_MEASURE_TIME_MS, aht20_fetch_start lê o resultado e
+// aht20_fetch_finish aguarda a transação e decodifica os dados
+bool aht20_trigger_start(i2c_inst_t *i2c, aht20_async_t *ctx, i2c_async_callback_t callback, void *user_data);
+bool aht20_fetch_start(i2c_inst_t *i2c, aht20_async_t *ctx, i2c_async_callback_t callback, void *user_data);
+bool aht20_fetch_finish(aht20_async_t *ctx, AHT20_Data *data);
+
 #endif // AHT20_H
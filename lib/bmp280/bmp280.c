@@ -1,3 +1,4 @@
+#include <string.h>
 #include "bmp280.h"
 #include "hardware/i2c.h"
 
@@ -9,30 +10,46 @@ void bmp280_init(i2c_inst_t *i2c) {
     buf[0] = REG_CONFIG;
     buf[1] = reg_config_val;
    
-    i2c_write_blocking(i2c, ADDR, buf, 2, false);
+    i2c_async_transfer_blocking(i2c, ADDR, buf, 2, NULL, 0);
 
     const uint8_t reg_ctrl_meas_val = (0x01 << 5) | (0x03 << 2) | (0x03);
     buf[0] = REG_CTRL_MEAS;
     buf[1] = reg_ctrl_meas_val;
-    i2c_write_blocking(i2c, ADDR, buf, 2, false);
+    i2c_async_transfer_blocking(i2c, ADDR, buf, 2, NULL, 0);
  //   printf("Ctrl_meas register value: %x\n", reg_ctrl_meas_val);
 }
 
-void bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure) {
-    uint8_t buf[6];
-    uint8_t reg = REG_PRESSURE_MSB;
-    i2c_write_blocking(i2c, ADDR, &reg, 1, true);
-    i2c_read_blocking(i2c, ADDR, buf, 6, false);
+bool bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure) {
+    bmp280_async_t ctx;
+    if (!bmp280_read_raw_start(i2c, &ctx, NULL, NULL)) {
+        *temp = 0;
+        *pressure = 0;
+        return false;
+    }
+    return bmp280_read_raw_finish(&ctx, temp, pressure);
+}
 
-    *pressure = (buf[0] << 12) | (buf[1] << 4) | (buf[2] >> 4);
-    *temp = (buf[3] << 12) | (buf[4] << 4) | (buf[5] >> 4);
+bool bmp280_read_raw_start(i2c_inst_t *i2c, bmp280_async_t *ctx, i2c_async_callback_t callback, void *user_data) {
+    ctx->reg = REG_PRESSURE_MSB;
+    return i2c_async_start(&ctx->xfer, i2c, ADDR, &ctx->reg, 1, ctx->buf, 6, callback, user_data);
+}
 
+bool bmp280_read_raw_finish(bmp280_async_t *ctx, int32_t* temp, int32_t* pressure) {
+    if (!i2c_async_wait(&ctx->xfer)) {
+        *temp = 0;
+        *pressure = 0;
+        return false;
+    }
 
+    uint8_t *buf = ctx->buf;
+    *pressure = (buf[0] << 12) | (buf[1] << 4) | (buf[2] >> 4);
+    *temp = (buf[3] << 12) | (buf[4] << 4) | (buf[5] >> 4);
+    return true;
 }
 
 void bmp280_reset(i2c_inst_t *i2c) {
     uint8_t buf[2] = { REG_RESET, 0xB6 };
-    i2c_write_blocking(i2c, ADDR, buf, 2, false);
+    i2c_async_transfer_blocking(i2c, ADDR, buf, 2, NULL, 0);
 }
 
 // função intermediária que calcula a temperatura de resolução fina
@@ -80,12 +97,29 @@ int32_t bmp280_convert_pressure(int32_t pressure, int32_t temp, struct bmp280_ca
     return converted;
 }
 
-void bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params) {
-    uint8_t buf[NUM_CALIB_PARAMS] = { 0 };
-    uint8_t reg = REG_DIG_T1_LSB;
-    i2c_write_blocking(i2c, ADDR, &reg, 1, true);
-    i2c_read_blocking(i2c, ADDR, buf, NUM_CALIB_PARAMS, false);
+bool bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params) {
+    bmp280_async_t ctx;
+    if (!bmp280_get_calib_params_start(i2c, &ctx, NULL, NULL)) {
+        memset(params, 0, sizeof(*params));
+        return false;
+    }
+    return bmp280_get_calib_params_finish(&ctx, params);
+}
+
+bool bmp280_get_calib_params_start(i2c_inst_t *i2c, bmp280_async_t *ctx, i2c_async_callback_t callback, void *user_data) {
+    // Leitura em rajada dos 24 bytes de calibração, feita pelo DMA
+    ctx->reg = REG_DIG_T1_LSB;
+    return i2c_async_start(&ctx->xfer, i2c, ADDR, &ctx->reg, 1, ctx->buf, NUM_CALIB_PARAMS, callback, user_data);
+}
 
+bool bmp280_get_calib_params_finish(bmp280_async_t *ctx, struct bmp280_calib_param* params) {
+    if (!i2c_async_wait(&ctx->xfer)) {
+        // Parâmetros zerados: a conversão da pressão resulta em 0
+        memset(params, 0, sizeof(*params));
+        return false;
+    }
+
+    uint8_t *buf = ctx->buf;
     params->dig_t1 = (uint16_t)(buf[1] << 8) | buf[0];
     params->dig_t2 = (int16_t)(buf[3] << 8) | buf[2];
     params->dig_t3 = (int16_t)(buf[5] << 8) | buf[4];
@@ -99,6 +133,5 @@ void bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params)
     params->dig_p7 = (int16_t)(buf[19] << 8) | buf[18];
     params->dig_p8 = (int16_t)(buf[21] << 8) | buf[20];
     params->dig_p9 = (int16_t)(buf[23] << 8) | buf[22];
-
-
+    return true;
 }
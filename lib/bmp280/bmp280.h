@@ -2,6 +2,7 @@
 #define BMP280_H
 
 #include "hardware/i2c.h"
+#include "../i2c_async/i2c_async.h"
 
 // Defina os endereços e registros conforme o código original
 #define ADDR _u(0x76)
@@ -61,12 +62,27 @@ struct bmp280_calib_param {
     int16_t dig_p9;
 };
 
+// Contexto de uma leitura assíncrona (via DMA) do BMP280
+typedef struct {
+    i2c_async_xfer_t xfer;
+    uint8_t reg;
+    uint8_t buf[NUM_CALIB_PARAMS];
+} bmp280_async_t;
+
 //void bmp280_init(void);
 void bmp280_init(i2c_inst_t *i2c);
-void bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure);
+bool bmp280_read_raw(i2c_inst_t *i2c, int32_t* temp, int32_t* pressure);
 void bmp280_reset(i2c_inst_t *i2c);
 int32_t bmp280_convert_temp(int32_t temp, struct bmp280_calib_param* params);
 int32_t bmp280_convert_pressure(int32_t pressure, int32_t temp, struct bmp280_calib_param* params);
-void bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params);
+bool bmp280_get_calib_params(i2c_inst_t *i2c, struct bmp280_calib_param* params);
+
+// Versões assíncronas: *_start dispara a transação e retorna imediatamente,
+// *_finish aguarda a conclusão e decodifica os dados. Em caso de falha, as
+// leituras (inclusive as síncronas acima) retornam false e zeram as saídas.
+bool bmp280_read_raw_start(i2c_inst_t *i2c, bmp280_async_t *ctx, i2c_async_callback_t callback, void *user_data);
+bool bmp280_read_raw_finish(bmp280_async_t *ctx, int32_t* temp, int32_t* pressure);
+bool bmp280_get_calib_params_start(i2c_inst_t *i2c, bmp280_async_t *ctx, i2c_async_callback_t callback, void *user_data);
+bool bmp280_get_calib_params_finish(bmp280_async_t *ctx, struct bmp280_calib_param* params);
 
 #endif
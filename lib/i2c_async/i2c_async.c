@@ -0,0 +1,266 @@
+#include "i2c_async.h"
+#include "pico/stdlib.h"
+#include "hardware/dma.h"
+#include "hardware/irq.h"
+#include "hardware/sync.h"
+
+// Estado de cada barramento I2C (índice 0 = i2c0, 1 = i2c1)
+typedef struct {
+    i2c_inst_t *i2c;
+    int tx_chan;
+    int rx_chan;
+    i2c_async_xfer_t *volatile current;
+} i2c_async_bus_t;
+
+static i2c_async_bus_t buses[2] = {
+    { .tx_chan = -1, .rx_chan = -1 },
+    { .tx_chan = -1, .rx_chan = -1 },
+};
+
+// Instrumentação: estatísticas e controle de sobreposição entre os barramentos
+static i2c_async_stats_t stats;
+static uint8_t active_mask = 0;     // Bit n = barramento n ocupado
+static uint64_t last_change_us = 0; // Instante da última mudança em active_mask
+
+// Atualiza a contagem de sobreposição. Chamar com interrupções desabilitadas
+// ou dentro do handler do I2C.
+static void bus_account(uint bus, bool active, uint64_t now) {
+    if (active_mask == 0x03) {
+        stats.overlap_us += now - last_change_us;
+    }
+    last_change_us = now;
+
+    if (active) {
+        active_mask |= (1u << bus);
+    } else {
+        active_mask &= ~(1u << bus);
+    }
+}
+
+// Encerra a transação corrente do barramento e chama o callback
+static void finish_xfer(uint bus, bool ok) {
+    i2c_async_bus_t *state = &buses[bus];
+    i2c_async_xfer_t *xfer = state->current;
+
+    i2c_get_hw(state->i2c)->intr_mask = 0;
+    if (xfer == NULL) {
+        return;
+    }
+
+    xfer->t_end = time_us_64();
+    xfer->ok = ok;
+
+    bus_account(bus, false, xfer->t_end);
+    stats.busy_us[bus] += xfer->t_end - xfer->t_start;
+    if (ok) {
+        stats.transfers[bus]++;
+    } else {
+        stats.errors[bus]++;
+    }
+
+    state->current = NULL;
+    xfer->done = true;
+
+    if (xfer->callback) {
+        xfer->callback(xfer, xfer->user_data);
+    }
+}
+
+static void i2c_async_irq(uint bus) {
+    i2c_async_bus_t *state = &buses[bus];
+    i2c_hw_t *hw = i2c_get_hw(state->i2c);
+    uint32_t status = hw->intr_stat;
+
+    // Transação abortada (NACK, perda de arbitragem): para os canais DMA
+    if (status & I2C_IC_INTR_STAT_R_TX_ABRT_BITS) {
+        dma_channel_abort(state->tx_chan);
+        dma_channel_abort(state->rx_chan);
+        (void)hw->clr_tx_abrt;
+        (void)hw->clr_stop_det;
+        finish_xfer(bus, false);
+        return;
+    }
+
+    if (status & I2C_IC_INTR_STAT_R_STOP_DET_BITS) {
+        (void)hw->clr_stop_det;
+
+        // O último byte já está na FIFO; espera o DMA terminar de drená-la
+        i2c_async_xfer_t *xfer = state->current;
+        if (xfer != NULL && xfer->rx_len > 0) {
+            while (dma_channel_is_busy(state->rx_chan)) {
+                tight_loop_contents();
+            }
+        }
+        finish_xfer(bus, true);
+    }
+}
+
+static void i2c0_async_irq(void) {
+    i2c_async_irq(0);
+}
+
+static void i2c1_async_irq(void) {
+    i2c_async_irq(1);
+}
+
+void i2c_async_init(i2c_inst_t *i2c) {
+    uint bus = i2c_hw_index(i2c);
+    i2c_async_bus_t *state = &buses[bus];
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+
+    state->i2c = i2c;
+    state->current = NULL;
+    if (state->tx_chan < 0) {
+        state->tx_chan = dma_claim_unused_channel(true);
+        state->rx_chan = dma_claim_unused_channel(true);
+    }
+
+    // Habilita as requisições de DMA do periférico.
+    // TX: pede dados quando a FIFO tiver 8 posições livres ou mais.
+    // RX: pede leitura assim que houver 1 byte na FIFO.
+    hw->dma_cr = I2C_IC_DMA_CR_TDMAE_BITS | I2C_IC_DMA_CR_RDMAE_BITS;
+    hw->dma_tdlr = 8;
+    hw->dma_rdlr = 0;
+    hw->intr_mask = 0;
+
+    uint irq_num = bus ? I2C1_IRQ : I2C0_IRQ;
+    irq_set_exclusive_handler(irq_num, bus ? i2c1_async_irq : i2c0_async_irq);
+    irq_set_enabled(irq_num, true);
+}
+
+bool i2c_async_start(i2c_async_xfer_t *xfer, i2c_inst_t *i2c, uint8_t addr,
+                     const uint8_t *src, size_t tx_len,
+                     uint8_t *dst, size_t rx_len,
+                     i2c_async_callback_t callback, void *user_data) {
+    // Descritor ainda em uso por uma transação em andamento: não pode ser
+    // alterado, senão o DMA e o callback dessa transação seriam corrompidos
+    if (buses[0].current == xfer || buses[1].current == xfer) {
+        return false;
+    }
+
+    // Uma transação que não pôde ser iniciada já conta como concluída com
+    // falha, para que i2c_async_wait() não fique bloqueado
+    size_t total = tx_len + rx_len;
+    uint bus = i2c_hw_index(i2c);
+    i2c_async_bus_t *state = &buses[bus];
+    if (total == 0 || total > I2C_ASYNC_MAX_LEN ||
+        state->current != NULL || state->tx_chan < 0) {
+        xfer->done = true;
+        xfer->ok = false;
+        return false;
+    }
+
+    xfer->i2c = i2c;
+    xfer->addr = addr;
+    xfer->dst = dst;
+    xfer->tx_len = tx_len;
+    xfer->rx_len = rx_len;
+    xfer->callback = callback;
+    xfer->user_data = user_data;
+
+    // Monta a sequência de comandos para DATA_CMD: bytes de escrita seguidos
+    // de comandos de leitura (RESTART no primeiro se houver escrita antes).
+    // O último comando leva o bit STOP.
+    size_t n = 0;
+    for (size_t i = 0; i < tx_len; i++) {
+        xfer->cmd[n++] = src[i];
+    }
+    for (size_t i = 0; i < rx_len; i++) {
+        uint16_t cmd = I2C_IC_DATA_CMD_CMD_BITS;
+        if (i == 0 && tx_len > 0) {
+            cmd |= I2C_IC_DATA_CMD_RESTART_BITS;
+        }
+        xfer->cmd[n++] = cmd;
+    }
+    xfer->cmd[n - 1] |= I2C_IC_DATA_CMD_STOP_BITS;
+
+    // Endereço do escravo (só pode ser alterado com o bloco desabilitado)
+    i2c_hw_t *hw = i2c_get_hw(i2c);
+    hw->enable = 0;
+    hw->tar = addr;
+    hw->enable = 1;
+
+    // Descarta restos de uma transação anterior abortada
+    while (hw->rxflr) {
+        (void)hw->data_cmd;
+    }
+    (void)hw->clr_stop_det;
+    (void)hw->clr_tx_abrt;
+
+    if (rx_len > 0) {
+        dma_channel_config c = dma_channel_get_default_config(state->rx_chan);
+        channel_config_set_transfer_data_size(&c, DMA_SIZE_8);
+        channel_config_set_read_increment(&c, false);
+        channel_config_set_write_increment(&c, true);
+        channel_config_set_dreq(&c, i2c_get_dreq(i2c, false));
+        dma_channel_configure(state->rx_chan, &c, dst, &hw->data_cmd, rx_len, true);
+    }
+
+    dma_channel_config c = dma_channel_get_default_config(state->tx_chan);
+    channel_config_set_transfer_data_size(&c, DMA_SIZE_16);
+    channel_config_set_read_increment(&c, true);
+    channel_config_set_write_increment(&c, false);
+    channel_config_set_dreq(&c, i2c_get_dreq(i2c, true));
+    dma_channel_configure(state->tx_chan, &c, &hw->data_cmd, xfer->cmd, total, false);
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    state->current = xfer;
+    xfer->done = false;
+    xfer->t_start = time_us_64();
+    bus_account(bus, true, xfer->t_start);
+    hw->intr_mask = I2C_IC_INTR_MASK_M_STOP_DET_BITS | I2C_IC_INTR_MASK_M_TX_ABRT_BITS;
+    dma_channel_start(state->tx_chan);
+    restore_interrupts(irq_state);
+
+    return true;
+}
+
+bool i2c_async_busy(i2c_inst_t *i2c) {
+    return buses[i2c_hw_index(i2c)].current != NULL;
+}
+
+bool i2c_async_wait(i2c_async_xfer_t *xfer) {
+    while (!xfer->done) {
+        tight_loop_contents();
+    }
+    return xfer->ok;
+}
+
+bool i2c_async_transfer_blocking(i2c_inst_t *i2c, uint8_t addr,
+                                 const uint8_t *src, size_t tx_len,
+                                 uint8_t *dst, size_t rx_len) {
+    i2c_async_xfer_t xfer;
+
+    // Erros que não se resolvem esperando: tamanhos inválidos ou barramento
+    // sem i2c_async_init()
+    size_t total = tx_len + rx_len;
+    if (total == 0 || total > I2C_ASYNC_MAX_LEN || buses[i2c_hw_index(i2c)].tx_chan < 0) {
+        return false;
+    }
+
+    // Resta apenas o barramento ocupado: aguarda a transação em curso e tenta
+    // de novo (outra transação pode ter ocupado o barramento nesse intervalo)
+    while (!i2c_async_start(&xfer, i2c, addr, src, tx_len, dst, rx_len, NULL, NULL)) {
+        while (i2c_async_busy(i2c)) {
+            tight_loop_contents();
+        }
+    }
+    return i2c_async_wait(&xfer);
+}
+
+void i2c_async_get_stats(i2c_async_stats_t *out) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    *out = stats;
+    // Inclui a sobreposição ainda em andamento
+    if (active_mask == 0x03) {
+        out->overlap_us += time_us_64() - last_change_us;
+    }
+    restore_interrupts(irq_state);
+}
+
+void i2c_async_reset_stats(void) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    stats = (i2c_async_stats_t){ 0 };
+    last_change_us = time_us_64();
+    restore_interrupts(irq_state);
+}
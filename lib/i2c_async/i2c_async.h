@@ -0,0 +1,79 @@
+#ifndef I2C_ASYNC_H
+#define I2C_ASYNC_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "hardware/i2c.h"
+
+// Camada de transações I2C assíncronas com DMA.
+// Cada barramento (i2c0 e i2c1) possui dois canais DMA: um alimenta o
+// registrador DATA_CMD com os comandos de escrita/leitura e outro drena a
+// FIFO de recepção. O fim da transação é detectado pela interrupção STOP_DET
+// do próprio periférico, que chama o callback do usuário. Assim as leituras
+// nos dois barramentos rodam em paralelo enquanto a CPU faz outro trabalho.
+
+// Maior transação suportada (escrita + leitura), em bytes.
+// Cobre a leitura em rajada dos 24 bytes de calibração do BMP280.
+#define I2C_ASYNC_MAX_LEN   32
+
+typedef struct i2c_async_xfer i2c_async_xfer_t;
+
+// Callback chamado (no contexto da interrupção) ao fim da transação
+typedef void (*i2c_async_callback_t)(i2c_async_xfer_t *xfer, void *user_data);
+
+// Descritor de uma transação. Deve permanecer válido até a conclusão.
+struct i2c_async_xfer {
+    i2c_inst_t *i2c;
+    uint8_t addr;
+    uint8_t *dst;
+    size_t tx_len;
+    size_t rx_len;
+    i2c_async_callback_t callback;
+    void *user_data;
+    volatile bool done;
+    volatile bool ok;
+    uint64_t t_start;   // Instante de início (us)
+    uint64_t t_end;     // Instante de término (us)
+    uint16_t cmd[I2C_ASYNC_MAX_LEN];
+};
+
+// Estatísticas de ocupação dos barramentos
+typedef struct {
+    uint32_t transfers[2];  // Transações concluídas por barramento
+    uint32_t errors[2];     // Transações abortadas (NACK, perda de arbitragem)
+    uint64_t busy_us[2];    // Tempo total de barramento ocupado
+    uint64_t overlap_us;    // Tempo com os dois barramentos ocupados ao mesmo tempo
+} i2c_async_stats_t;
+
+// Reserva os canais DMA e instala a interrupção do barramento.
+// Deve ser chamada após i2c_init().
+void i2c_async_init(i2c_inst_t *i2c);
+
+// Inicia uma transação: escreve tx_len bytes de src e, em seguida (com
+// RESTART), lê rx_len bytes para dst. Retorna false se o barramento estiver
+// ocupado, se os tamanhos forem inválidos ou se o próprio descritor ainda
+// estiver em uso; neste último caso o descritor não é alterado.
+bool i2c_async_start(i2c_async_xfer_t *xfer, i2c_inst_t *i2c, uint8_t addr,
+                     const uint8_t *src, size_t tx_len,
+                     uint8_t *dst, size_t rx_len,
+                     i2c_async_callback_t callback, void *user_data);
+
+// Indica se há uma transação em andamento no barramento
+bool i2c_async_busy(i2c_inst_t *i2c);
+
+// Aguarda a conclusão da transação e retorna se ela foi bem-sucedida
+bool i2c_async_wait(i2c_async_xfer_t *xfer);
+
+// Equivalente síncrono: inicia a transação e aguarda sua conclusão
+bool i2c_async_transfer_blocking(i2c_inst_t *i2c, uint8_t addr,
+                                 const uint8_t *src, size_t tx_len,
+                                 uint8_t *dst, size_t rx_len);
+
+// Copia as estatísticas acumuladas de ocupação dos barramentos
+void i2c_async_get_stats(i2c_async_stats_t *stats);
+
+// Zera as estatísticas acumuladas
+void i2c_async_reset_stats(void);
+
+#endif // I2C_ASYNC_H
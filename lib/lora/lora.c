@@ -69,21 +69,34 @@ void lora_setup(lora_config_t *config) {
     writeRegister(config, REG_OPMODE, RF95_MODE_SLEEP | 0x80); // 0x80 = bit 7 em 1 para LoRa
     sleep_ms(10);
 
-    // 3.2. Definir Frequência de Operação (915 MHz)
-    SetFrequency(config, 915.0);
+    // 3.2. Definir Frequência de Operação (padrão 915 MHz)
+    uint32_t frequency_khz = config->frequency_khz ? config->frequency_khz : LORA_DEFAULT_FREQUENCY_KHZ;
+    SetFrequency(config, frequency_khz / 1000.0);
 
     // 3.3. Configuração do Rádio LoRa – BW, FS, CR, LDRO, etc.
-    writeRegister(config, REG_MODEM_CONFIG, BANDWIDTH_125K | ERROR_CODING_4_5);
-    writeRegister(config, REG_MODEM_CONFIG2, SPREADING_7 | CRC_OFF);
-    // Configura o cabeçalho implícito (Implicit Header)
-    writeRegister(config, REG_MODEM_CONFIG3, 0x04); // LNA gain boost
+    uint8_t spreading = config->spreading ? config->spreading : LORA_DEFAULT_SPREADING;
+    uint8_t modem_config = config->modem_config ? config->modem_config : LORA_DEFAULT_MODEM_CONFIG;
+    writeRegister(config, REG_MODEM_CONFIG, modem_config);
+    writeRegister(config, REG_MODEM_CONFIG2, spreading | CRC_ON);
+    // LNA gain boost; símbolos acima de 16 ms (ex.: SF11/SF12 em 125 kHz)
+    // exigem também o Low Data Rate Optimize (bit 3)
+    static const uint32_t bandwidth_hz[] = {
+        7800, 10400, 15600, 20800, 31250, 41700, 62500, 125000, 250000, 500000
+    };
+    uint8_t bw_index = modem_config >> 4;
+    uint32_t symbol_us = bw_index < 10 ? ((1u << (spreading >> 4)) * 1000000u) / bandwidth_hz[bw_index] : 0;
+    bool low_data_rate = symbol_us > 16000;
+    writeRegister(config, REG_MODEM_CONFIG3, low_data_rate ? 0x0C : 0x04);
 
     // --- Configuração da Potência de Transmissão (TX Power) ---
-    writeRegister(config, REG_PA_CONFIG, 0x8F); // PA_BOOST com a potência máxima de 17 dBm
+    writeRegister(config, REG_PA_CONFIG, config->tx_power ? config->tx_power : LORA_DEFAULT_TX_POWER);
 
-    // 3.4. Definir tamanho do Payload.
+    // 3.4. Definir tamanho do Payload. No modo de cabeçalho explícito, o
+    // rádio rejeita (erro de CRC do cabeçalho) pacotes maiores que
+    // REG_MAX_PAYLOAD_LENGTH: libera o máximo, pois o quadro seguro passa
+    // de 15 bytes. O tamanho de cada envio é definido em lora_send_packet.
     writeRegister(config, REG_PAYLOAD_LENGTH, 15);
-    writeRegister(config, REG_MAX_PAYLOAD_LENGTH, 15);
+    writeRegister(config, REG_MAX_PAYLOAD_LENGTH, 0xFF);
 
     // 3.5. Mudar para modo STANDBY
     writeRegister(config, REG_OPMODE, RF95_MODE_STANDBY);
@@ -133,6 +146,11 @@ bool lora_receive_packet(lora_config_t *config, uint8_t* buffer, uint8_t* len) {
         // Limpar flags de interrupção
         writeRegister(config, REG_IRQ_FLAGS, 0xFF);
 
+        // Descarta pacotes com erro de CRC (bit PayloadCrcError)
+        if ((irq_flags & 0x20) != 0) {
+            return false;
+        }
+
         // Obter o tamanho do pacote recebido
         uint8_t packet_len = readRegister(config, REG_RX_NB_BYTES);
         *len = packet_len;
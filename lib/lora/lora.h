@@ -22,6 +22,8 @@
 #define REG_IRQ_FLAGS_MASK          0x11
 #define REG_IRQ_FLAGS               0x12
 #define REG_RX_NB_BYTES             0x13            //IMPORTANTE
+#define REG_PKT_SNR_VALUE           0x19
+#define REG_PKT_RSSI_VALUE          0x1A
 #define REG_MODEM_CONFIG            0x1D            //IMPORTANTE
 #define REG_MODEM_CONFIG2           0x1E            //IMPORTANTE
 #define REG_MODEM_CONFIG3           0x26            //IMPORTANTE
@@ -123,8 +125,20 @@ typedef struct {
     uint8_t pin_sck;
     uint8_t pin_mosi;
     uint8_t pin_miso;
+    uint8_t pin_dio0;   // DIO0 (RxDone/TxDone) - usado apenas no modo gateway
+
+    // Parâmetros de rádio aplicados por lora_setup (0 = valor padrão)
+    uint32_t frequency_khz; // Padrão: LORA_DEFAULT_FREQUENCY_KHZ
+    uint8_t spreading;      // SPREADING_x. Padrão: SPREADING_7
+    uint8_t modem_config;   // BANDWIDTH_x | ERROR_CODING_x. Padrão: 125 kHz, 4/5
+    uint8_t tx_power;       // Valor de REG_PA_CONFIG. Padrão: PA_MAX_BOOST
 } lora_config_t;
 
+#define LORA_DEFAULT_FREQUENCY_KHZ  915000
+#define LORA_DEFAULT_SPREADING      SPREADING_7
+#define LORA_DEFAULT_MODEM_CONFIG   (BANDWIDTH_125K | ERROR_CODING_4_5)
+#define LORA_DEFAULT_TX_POWER       PA_MAX_BOOST
+
 // Protótipos de funções atualizados
 void lora_setup(lora_config_t *config);
 void lora_send_packet(lora_config_t *config, uint8_t* data, uint8_t len);
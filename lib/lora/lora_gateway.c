@@ -0,0 +1,178 @@
+#include <string.h>
+#include "lora_gateway.h"
+#include "hardware/gpio.h"
+#include "hardware/sync.h"
+
+#define IRQ_RX_DONE             0x40
+#define IRQ_PAYLOAD_CRC_ERROR   0x20
+
+// Gateway atendido pelo callback de GPIO (o SDK permite um callback por núcleo)
+static lora_gateway_t *active_gateway = NULL;
+
+// Interrupção do DIO0: registra o instante e desliga a IRQ do pino até que
+// lora_gateway_poll() leia o pacote e limpe as flags do rádio. Como a IRQ é
+// por nível, um RxDone que chegue durante a leitura não é perdido.
+static void lora_gateway_gpio_irq(uint gpio, uint32_t events) {
+    lora_gateway_t *gw = active_gateway;
+    if (gw == NULL || !(events & GPIO_IRQ_LEVEL_HIGH)) {
+        return;
+    }
+
+    for (uint8_t i = 0; i < gw->num_radios; i++) {
+        lora_radio_t *radio = &gw->radios[i];
+        if (radio->config->pin_dio0 == gpio) {
+            gpio_set_irq_enabled(gpio, GPIO_IRQ_LEVEL_HIGH, false);
+            radio->irq_time_us = time_us_64();
+            radio->pending = true;
+            return;
+        }
+    }
+}
+
+void lora_gateway_init(lora_gateway_t *gw) {
+    memset(gw, 0, sizeof(*gw));
+}
+
+int lora_gateway_add_radio(lora_gateway_t *gw, lora_config_t *config) {
+    if (gw->num_radios >= LORA_GATEWAY_MAX_RADIOS) {
+        return -1;
+    }
+
+    lora_radio_t *radio = &gw->radios[gw->num_radios];
+    radio->config = config;
+    radio->pending = false;
+    memset(&radio->stats, 0, sizeof(radio->stats));
+
+    return gw->num_radios++;
+}
+
+void lora_gateway_start(lora_gateway_t *gw) {
+    active_gateway = gw;
+
+    for (uint8_t i = 0; i < gw->num_radios; i++) {
+        lora_radio_t *radio = &gw->radios[i];
+        lora_config_t *config = radio->config;
+
+        // Canal e SF próprios do rádio, aplicados por lora_setup
+        lora_setup(config);
+
+        // DIO0 = RxDone
+        writeRegister(config, REG_DIO_MAPPING_1, 0x00);
+
+        gpio_init(config->pin_dio0);
+        gpio_set_dir(config->pin_dio0, GPIO_IN);
+        gpio_set_irq_enabled_with_callback(config->pin_dio0, GPIO_IRQ_LEVEL_HIGH, true,
+                                           &lora_gateway_gpio_irq);
+
+        lora_receive_continuous(config);
+        // Libera no DIO0/RegIrqFlags apenas RxDone e PayloadCrcError
+        writeRegister(config, REG_IRQ_FLAGS_MASK, (uint8_t)~(IRQ_RX_DONE | IRQ_PAYLOAD_CRC_ERROR));
+    }
+}
+
+// Insere o quadro na fila mantendo a ordem crescente de timestamp
+static bool queue_insert(lora_gateway_t *gw, const lora_frame_t *frame) {
+    if (gw->queue_count >= LORA_GATEWAY_QUEUE_LEN) {
+        return false;
+    }
+
+    int pos = gw->queue_count;
+    while (pos > 0 && gw->queue[pos - 1].timestamp_us > frame->timestamp_us) {
+        gw->queue[pos] = gw->queue[pos - 1];
+        pos--;
+    }
+    gw->queue[pos] = *frame;
+    gw->queue_count++;
+    return true;
+}
+
+// Lê o pacote sinalizado pelo rádio. Retorna true se o quadro for válido.
+static bool read_frame(lora_radio_t *radio, lora_frame_t *frame) {
+    lora_config_t *config = radio->config;
+
+    uint8_t irq_flags = readRegister(config, REG_IRQ_FLAGS);
+    writeRegister(config, REG_IRQ_FLAGS, 0xFF);
+
+    if ((irq_flags & IRQ_RX_DONE) == 0) {
+        return false;
+    }
+    if (irq_flags & IRQ_PAYLOAD_CRC_ERROR) {
+        radio->stats.crc_errors++;
+        return false;
+    }
+
+    // Um quadro cortado estaria corrompido (e o quadro seguro falharia na
+    // autenticação): é contado e descartado
+    uint8_t packet_len = readRegister(config, REG_RX_NB_BYTES);
+    if (packet_len > LORA_GATEWAY_MAX_FRAME) {
+        radio->stats.truncated++;
+        return false;
+    }
+
+    writeRegister(config, REG_FIFO_ADDR_PTR, readRegister(config, REG_FIFO_RX_CURRENT_ADDR));
+    for (int i = 0; i < packet_len; i++) {
+        frame->data[i] = readRegister(config, REG_FIFO);
+    }
+    frame->data[packet_len] = '\0';
+    frame->len = packet_len;
+
+    // RSSI do pacote: offset de -157 dBm na porta HF e -164 dBm na LF
+    uint32_t frequency_khz = config->frequency_khz ? config->frequency_khz : LORA_DEFAULT_FREQUENCY_KHZ;
+    int16_t rssi_offset = frequency_khz > 525000 ? -157 : -164;
+    frame->rssi = rssi_offset + readRegister(config, REG_PKT_RSSI_VALUE);
+    frame->snr = (int8_t)readRegister(config, REG_PKT_SNR_VALUE) / 4;
+
+    radio->stats.last_rssi = frame->rssi;
+    radio->stats.last_snr = frame->snr;
+    return true;
+}
+
+int lora_gateway_poll(lora_gateway_t *gw) {
+    int inserted = 0;
+
+    for (uint8_t i = 0; i < gw->num_radios; i++) {
+        lora_radio_t *radio = &gw->radios[i];
+        if (!radio->pending) {
+            continue;
+        }
+
+        lora_frame_t frame;
+        uint32_t irq_state = save_and_disable_interrupts();
+        frame.timestamp_us = radio->irq_time_us;
+        radio->pending = false;
+        restore_interrupts(irq_state);
+        frame.radio = i;
+
+        if (read_frame(radio, &frame)) {
+            if (queue_insert(gw, &frame)) {
+                radio->stats.rx_ok++;
+                inserted++;
+            } else {
+                radio->stats.dropped++;
+            }
+        }
+
+        // Flags limpas: reabilita a IRQ do DIO0 deste rádio
+        gpio_set_irq_enabled(radio->config->pin_dio0, GPIO_IRQ_LEVEL_HIGH, true);
+    }
+
+    return inserted;
+}
+
+bool lora_gateway_pop(lora_gateway_t *gw, lora_frame_t *frame) {
+    if (gw->queue_count == 0) {
+        return false;
+    }
+
+    *frame = gw->queue[0];
+    gw->queue_count--;
+    memmove(&gw->queue[0], &gw->queue[1], gw->queue_count * sizeof(lora_frame_t));
+    return true;
+}
+
+const lora_radio_stats_t *lora_gateway_stats(lora_gateway_t *gw, uint8_t idx) {
+    if (idx >= gw->num_radios) {
+        return NULL;
+    }
+    return &gw->radios[idx].stats;
+}
@@ -0,0 +1,75 @@
+// lora_gateway.h
+/* Modo gateway: recepção simultânea em vários módulos SX1276.
+ * Cada rádio tem sua própria frequência/SF (campos frequency_khz e spreading
+ * do lora_config_t) e sinaliza RxDone pelo pino DIO0.
+ * A interrupção apenas registra o instante de chegada; lora_gateway_poll()
+ * descarrega as FIFOs dos rádios numa fila única ordenada por timestamp.
+ */
+
+#ifndef LORA_GATEWAY_INCLUDED
+#define LORA_GATEWAY_INCLUDED
+
+#include "lora.h"
+
+#define LORA_GATEWAY_MAX_RADIOS     4
+#define LORA_GATEWAY_QUEUE_LEN      16
+#define LORA_GATEWAY_MAX_FRAME      64
+
+// Quadro recebido por um dos rádios
+typedef struct {
+    uint64_t timestamp_us;  // Instante do RxDone (borda de subida do DIO0)
+    uint8_t radio;          // Índice do rádio que recebeu
+    int16_t rssi;           // RSSI do pacote (dBm)
+    int8_t snr;             // SNR do pacote (dB)
+    uint8_t len;
+    uint8_t data[LORA_GATEWAY_MAX_FRAME + 1]; // +1 para o terminador nulo
+} lora_frame_t;
+
+// Estatísticas por rádio
+typedef struct {
+    uint32_t rx_ok;         // Pacotes entregues na fila
+    uint32_t crc_errors;    // Pacotes descartados por erro de CRC
+    uint32_t truncated;     // Pacotes descartados por exceder LORA_GATEWAY_MAX_FRAME
+    uint32_t dropped;       // Pacotes perdidos por fila cheia
+    int16_t last_rssi;
+    int8_t last_snr;
+} lora_radio_stats_t;
+
+typedef struct {
+    lora_config_t *config;  // Inclui frequência e SF do rádio
+    volatile bool pending;  // RxDone aguardando leitura
+    volatile uint64_t irq_time_us;
+    lora_radio_stats_t stats;
+} lora_radio_t;
+
+typedef struct {
+    lora_radio_t radios[LORA_GATEWAY_MAX_RADIOS];
+    uint8_t num_radios;
+
+    // Fila única mantida em ordem crescente de timestamp
+    lora_frame_t queue[LORA_GATEWAY_QUEUE_LEN];
+    uint8_t queue_count;
+} lora_gateway_t;
+
+// Prepara a estrutura do gateway (sem rádios)
+void lora_gateway_init(lora_gateway_t *gw);
+
+// Registra um rádio; frequência e SF vêm de config->frequency_khz e
+// config->spreading. Retorna o índice do rádio ou -1 se não houver espaço.
+int lora_gateway_add_radio(lora_gateway_t *gw, lora_config_t *config);
+
+// Configura todos os rádios, habilita as interrupções de DIO0 e entra em
+// recepção contínua. Apenas um gateway pode estar ativo por vez.
+void lora_gateway_start(lora_gateway_t *gw);
+
+// Lê os pacotes sinalizados pelos rádios e os insere na fila.
+// Retorna o número de quadros inseridos.
+int lora_gateway_poll(lora_gateway_t *gw);
+
+// Retira o quadro mais antigo da fila
+bool lora_gateway_pop(lora_gateway_t *gw, lora_frame_t *frame);
+
+// Estatísticas do rádio de índice idx
+const lora_radio_stats_t *lora_gateway_stats(lora_gateway_t *gw, uint8_t idx);
+
+#endif
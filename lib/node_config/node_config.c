@@ -0,0 +1,98 @@
+#include <string.h>
+#include "node_config.h"
+#include "hardware/regs/addressmap.h"
+
+uint32_t node_config_crc32(const uint8_t *data, size_t len) {
+    uint32_t crc = 0xFFFFFFFFu;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= data[i];
+        for (int bit = 0; bit < 8; bit++) {
+            crc = (crc >> 1) ^ (0xEDB88320u & -(crc & 1u));
+        }
+    }
+    return ~crc;
+}
+
+void node_config_defaults(node_config_t *cfg, node_role_t role) {
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->magic = NODE_CONFIG_MAGIC;
+    cfg->version = NODE_CONFIG_VERSION;
+    cfg->role = role;
+    cfg->node_id = 1;
+    cfg->num_radios = role == NODE_ROLE_GATEWAY ? 2 : 1;
+
+    for (int i = 0; i < NODE_CONFIG_MAX_RADIOS; i++) {
+        cfg->radio[i].frequency_khz = LORA_DEFAULT_FREQUENCY_KHZ;
+        cfg->radio[i].spreading = LORA_DEFAULT_SPREADING;
+        cfg->radio[i].modem_config = LORA_DEFAULT_MODEM_CONFIG;
+        cfg->radio[i].tx_power = LORA_DEFAULT_TX_POWER;
+    }
+    // Segundo rádio do gateway em outro canal/SF
+    cfg->radio[1].frequency_khz = 916800;
+    cfg->radio[1].spreading = SPREADING_9;
+
+    cfg->sample_interval_ms = 2000;
+    cfg->report_interval_ms = 10000;
+    cfg->crc32 = node_config_crc32((const uint8_t *)cfg, offsetof(node_config_t, crc32));
+}
+
+static bool radio_valid(const node_radio_config_t *radio) {
+    uint8_t bandwidth = radio->modem_config & 0xF0;
+    uint8_t coding = radio->modem_config & 0x0E;
+
+    // lora_setup só opera com cabeçalho explícito: ficam de fora o SF6 (exige
+    // cabeçalho implícito e os ajustes DETECT_OPT/DETECTION_THRESHOLD) e o
+    // bit 0 de modem_config (ImplicitHeaderModeOn)
+    return radio->frequency_khz >= 137000 && radio->frequency_khz <= 1020000 &&
+           radio->spreading >= SPREADING_7 && radio->spreading <= SPREADING_12 &&
+           (radio->spreading & 0x0F) == 0 &&
+           bandwidth <= BANDWIDTH_500K &&
+           coding >= ERROR_CODING_4_5 && coding <= ERROR_CODING_4_8 &&
+           (radio->modem_config & 0x01) == 0 &&
+           radio->tx_power != 0 &&
+           radio->reserved == 0;
+}
+
+bool node_config_validate(const node_config_t *cfg) {
+    if (cfg->magic != NODE_CONFIG_MAGIC || cfg->version != NODE_CONFIG_VERSION) {
+        return false;
+    }
+    if (cfg->crc32 != node_config_crc32((const uint8_t *)cfg, offsetof(node_config_t, crc32))) {
+        return false;
+    }
+    if (cfg->role < NODE_ROLE_TX || cfg->role > NODE_ROLE_GATEWAY) {
+        return false;
+    }
+    if (cfg->num_radios == 0 || cfg->num_radios > NODE_CONFIG_MAX_RADIOS) {
+        return false;
+    }
+    for (int i = 0; i < cfg->num_radios; i++) {
+        if (!radio_valid(&cfg->radio[i])) {
+            return false;
+        }
+    }
+    return cfg->sample_interval_ms >= 100 && cfg->report_interval_ms >= 100;
+}
+
+bool node_config_load(node_config_t *cfg, node_role_t role) {
+    // A flash é mapeada na memória (XIP): o bloco é lido diretamente
+    const node_config_t *stored = (const node_config_t *)(XIP_BASE + NODE_CONFIG_FLASH_OFFSET);
+
+    node_config_t copy;
+    memcpy(&copy, stored, sizeof(copy));
+    if (node_config_validate(&copy) && copy.role == role) {
+        *cfg = copy;
+        return true;
+    }
+
+    node_config_defaults(cfg, role);
+    return false;
+}
+
+void node_config_apply_radio(const node_config_t *cfg, uint8_t idx, lora_config_t *lora) {
+    const node_radio_config_t *radio = &cfg->radio[idx];
+    lora->frequency_khz = radio->frequency_khz;
+    lora->spreading = radio->spreading;
+    lora->modem_config = radio->modem_config;
+    lora->tx_power = radio->tx_power;
+}
@@ -0,0 +1,66 @@
+#ifndef NODE_CONFIG_H
+#define NODE_CONFIG_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "../lora/lora.h"
+
+// Bloco de configuração binário gravado no último setor da flash.
+// Permite ajustar papel, identificador, parâmetros de rádio e intervalos de
+// cada nó sem recompilar o firmware (ver tools/node_config.py).
+// Todos os campos são little-endian; o CRC-32 (IEEE) cobre os bytes
+// anteriores a ele.
+
+#define NODE_CONFIG_MAGIC       0x46434E4Cu  // "LNCF"
+#define NODE_CONFIG_VERSION     1
+#define NODE_CONFIG_MAX_RADIOS  2
+
+// Deslocamento do bloco na flash: último setor de 4 KB
+#define NODE_CONFIG_FLASH_OFFSET    (PICO_FLASH_SIZE_BYTES - 4096)
+
+typedef enum {
+    NODE_ROLE_TX = 1,
+    NODE_ROLE_RX = 2,
+    NODE_ROLE_GATEWAY = 3,
+} node_role_t;
+
+typedef struct {
+    uint32_t frequency_khz;
+    uint8_t spreading;      // SPREADING_x
+    uint8_t modem_config;   // BANDWIDTH_x | ERROR_CODING_x
+    uint8_t tx_power;       // Valor de REG_PA_CONFIG
+    uint8_t reserved;
+} node_radio_config_t;
+
+typedef struct {
+    uint32_t magic;
+    uint8_t version;
+    uint8_t role;               // node_role_t
+    uint8_t node_id;
+    uint8_t num_radios;
+    node_radio_config_t radio[NODE_CONFIG_MAX_RADIOS];
+    uint32_t sample_interval_ms;    // TX: intervalo entre leituras/envios
+    uint32_t report_interval_ms;    // RX/gateway: intervalo entre relatórios
+    uint32_t crc32;
+} node_config_t;
+
+_Static_assert(sizeof(node_config_t) == 36, "layout do bloco de configuração");
+
+// Preenche a configuração padrão (equivalente aos valores antes fixos no código)
+void node_config_defaults(node_config_t *cfg, node_role_t role);
+
+// Confere magic, versão, CRC e faixas dos campos
+bool node_config_validate(const node_config_t *cfg);
+
+// Carrega o bloco da flash. Se ele for inválido ou de outro papel, usa os
+// valores padrão. Retorna true se a configuração veio da flash.
+bool node_config_load(node_config_t *cfg, node_role_t role);
+
+// Copia os parâmetros do rádio idx para a configuração do módulo LoRa
+void node_config_apply_radio(const node_config_t *cfg, uint8_t idx, lora_config_t *lora);
+
+// CRC-32 (IEEE 802.3, o mesmo do zlib)
+uint32_t node_config_crc32(const uint8_t *data, size_t len);
+
+#endif // NODE_CONFIG_H
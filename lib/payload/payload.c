@@ -0,0 +1,12 @@
+#include <stdio.h>
+#include "payload.h"
+
+int format_data_string(char* buffer, size_t size, float temp_bmp, float temp_aht, float hum_aht) {
+    return snprintf(buffer, size, "T1:%.2f,T2:%.2f,H:%.2f", temp_bmp, temp_aht, hum_aht);
+}
+
+bool parse_data_string(const char* data, float* temp_bmp, float* temp_aht, float* hum_aht) {
+    // Formato esperado: "T1:XX.XX,T2:XX.XX,H:XX.XX"
+    int result = sscanf(data, "T1:%f,T2:%f,H:%f", temp_bmp, temp_aht, hum_aht);
+    return (result == 3); // Retorna true se conseguiu extrair os 3 valores
+}
@@ -0,0 +1,16 @@
+#ifndef PAYLOAD_H
+#define PAYLOAD_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+// Formato do payload de telemetria: "T1:XX.XX,T2:XX.XX,H:XX.XX"
+//  T1 = temperatura do BMP280, T2 = temperatura do AHT20, H = umidade do AHT20
+
+// Formata as leituras no buffer. Retorna o tamanho da string gerada.
+int format_data_string(char* buffer, size_t size, float temp_bmp, float temp_aht, float hum_aht);
+
+// Função para extrair valores da string
+bool parse_data_string(const char* data, float* temp_bmp, float* temp_aht, float* hum_aht);
+
+#endif // PAYLOAD_H
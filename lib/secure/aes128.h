@@ -0,0 +1,44 @@
+#ifndef AES128_H
+#define AES128_H
+
+#include <stddef.h>
+#include <stdint.h>
+
+// Núcleo AES-128 sem alocação dinâmica: cifragem de bloco, modo CTR (in
+// place) e CMAC (RFC 4493). Apenas a direção de cifragem é implementada,
+// pois CTR e CMAC não usam a decifragem.
+
+#define AES128_BLOCK_SIZE   16
+
+// Chave expandida (11 subchaves de rodada)
+typedef struct {
+    uint32_t rk[44];
+} aes128_ctx_t;
+
+// Chave expandida + subchaves K1/K2 do CMAC
+typedef struct {
+    aes128_ctx_t aes;
+    uint8_t k1[AES128_BLOCK_SIZE];
+    uint8_t k2[AES128_BLOCK_SIZE];
+} aes128_cmac_ctx_t;
+
+// Expande a chave de 16 bytes
+void aes128_init(aes128_ctx_t *ctx, const uint8_t key[AES128_BLOCK_SIZE]);
+
+// Cifra um bloco (in e out podem ser o mesmo buffer)
+void aes128_encrypt_block(const aes128_ctx_t *ctx, const uint8_t in[AES128_BLOCK_SIZE],
+                          uint8_t out[AES128_BLOCK_SIZE]);
+
+// Aplica o keystream CTR sobre data, no próprio buffer. O contador é
+// incrementado (big-endian) a cada bloco consumido.
+void aes128_ctr_xor(const aes128_ctx_t *ctx, uint8_t counter[AES128_BLOCK_SIZE],
+                    uint8_t *data, size_t len);
+
+// Prepara a chave e as subchaves do CMAC
+void aes128_cmac_init(aes128_cmac_ctx_t *ctx, const uint8_t key[AES128_BLOCK_SIZE]);
+
+// Calcula o CMAC de 16 bytes da mensagem
+void aes128_cmac(const aes128_cmac_ctx_t *ctx, const uint8_t *msg, size_t len,
+                 uint8_t mac[AES128_BLOCK_SIZE]);
+
+#endif // AES128_H
@@ -0,0 +1,215 @@
+#include <string.h>
+#include "counter_store.h"
+#include "hardware/flash.h"
+#include "hardware/sync.h"
+#include "hardware/regs/addressmap.h"
+
+// Registro do log. Um slot com todos os bytes em 0xFF está livre; o CRC
+// descarta registros gravados pela metade.
+typedef struct {
+    uint8_t node_id;
+    uint8_t reserved[3];
+    uint32_t seq;       // Ordem de gravação, crescente entre os dois setores
+    uint32_t value;
+    uint32_t crc32;
+} counter_record_t;
+
+_Static_assert(sizeof(counter_record_t) == 16, "registro do log de contadores");
+
+#define RECORDS_PER_SECTOR  (FLASH_SECTOR_SIZE / sizeof(counter_record_t))
+
+typedef struct {
+    uint32_t max_seq;   // Maior seq válido do setor (0 se não houver)
+    int next_free;      // Slot seguinte ao último ocupado, ou -1 se cheio
+                        // (0 = setor apagado)
+} sector_info_t;
+
+static uint32_t sector_offset(int sector) {
+    return COUNTER_STORE_FLASH_OFFSET + sector * FLASH_SECTOR_SIZE;
+}
+
+static const counter_record_t *sector_records(int sector) {
+    return (const counter_record_t *)(XIP_BASE + sector_offset(sector));
+}
+
+static bool record_empty(const counter_record_t *rec) {
+    const uint8_t *bytes = (const uint8_t *)rec;
+    for (size_t i = 0; i < sizeof(*rec); i++) {
+        if (bytes[i] != 0xFF) {
+            return false;
+        }
+    }
+    return true;
+}
+
+static bool record_valid(const counter_record_t *rec) {
+    return !record_empty(rec) &&
+           rec->crc32 == node_config_crc32((const uint8_t *)rec, offsetof(counter_record_t, crc32));
+}
+
+static void scan_sector(int sector, sector_info_t *info) {
+    const counter_record_t *records = sector_records(sector);
+    int last_used = -1;
+
+    info->max_seq = 0;
+    for (int i = 0; i < (int)RECORDS_PER_SECTOR; i++) {
+        if (record_empty(&records[i])) {
+            continue;
+        }
+        last_used = i;
+        if (record_valid(&records[i]) && records[i].seq > info->max_seq) {
+            info->max_seq = records[i].seq;
+        }
+    }
+    info->next_free = last_used + 1 < (int)RECORDS_PER_SECTOR ? last_used + 1 : -1;
+}
+
+// Grava um registro no slot indicado e confere a leitura pela XIP
+static bool write_record(int sector, int slot, uint8_t node_id, uint32_t seq, uint32_t value) {
+    counter_record_t rec;
+    memset(&rec, 0, sizeof(rec));
+    rec.node_id = node_id;
+    rec.seq = seq;
+    rec.value = value;
+    rec.crc32 = node_config_crc32((const uint8_t *)&rec, offsetof(counter_record_t, crc32));
+
+    // A programação é feita por página; bytes em 0xFF não alteram a flash
+    uint32_t offset = sector_offset(sector) + slot * sizeof(rec);
+    uint32_t page_offset = offset & ~(uint32_t)(FLASH_PAGE_SIZE - 1);
+    uint8_t page[FLASH_PAGE_SIZE];
+    memset(page, 0xFF, sizeof(page));
+    memcpy(page + (offset - page_offset), &rec, sizeof(rec));
+
+    uint32_t irq_state = save_and_disable_interrupts();
+    flash_range_program(page_offset, page, FLASH_PAGE_SIZE);
+    restore_interrupts(irq_state);
+
+    return memcmp(&sector_records(sector)[slot], &rec, sizeof(rec)) == 0;
+}
+
+static void erase_sector(int sector) {
+    uint32_t irq_state = save_and_disable_interrupts();
+    flash_range_erase(sector_offset(sector), FLASH_SECTOR_SIZE);
+    restore_interrupts(irq_state);
+}
+
+// Maior valor do nó num setor (0 se não houver)
+static uint32_t sector_load(int sector, uint8_t node_id) {
+    const counter_record_t *records = sector_records(sector);
+    uint32_t value = 0;
+    for (int i = 0; i < (int)RECORDS_PER_SECTOR; i++) {
+        if (records[i].node_id == node_id && record_valid(&records[i]) &&
+            records[i].value > value) {
+            value = records[i].value;
+        }
+    }
+    return value;
+}
+
+uint32_t counter_store_load(uint8_t node_id) {
+    // Os limites só crescem: vale o maior registro válido do nó
+    uint32_t value0 = sector_load(0, node_id);
+    uint32_t value1 = sector_load(1, node_id);
+    return value0 > value1 ? value0 : value1;
+}
+
+// Fora de uma compactação, o setor sem o maior seq está apagado. Se não
+// estiver, uma compactação foi interrompida (na cópia ou antes de apagar a
+// origem): copia para o setor atual os valores que só existem no outro e
+// então o apaga, para que a próxima compactação nunca apague a única cópia
+// de um limite.
+static bool repair(int current, sector_info_t *info) {
+    int other = 1 - current;
+    const counter_record_t *records = sector_records(other);
+    for (int i = 0; i < (int)RECORDS_PER_SECTOR; i++) {
+        if (!record_valid(&records[i]) ||
+            records[i].value <= sector_load(current, records[i].node_id)) {
+            continue;
+        }
+        if (info[current].next_free < 0 ||
+            !write_record(current, info[current].next_free, records[i].node_id,
+                          ++info[current].max_seq, records[i].value)) {
+            return false;
+        }
+        info[current].next_free++;
+        if (info[current].next_free == (int)RECORDS_PER_SECTOR) {
+            info[current].next_free = -1;
+        }
+    }
+    erase_sector(other);
+    info[other].max_seq = 0;
+    info[other].next_free = 0;
+    return true;
+}
+
+static bool store_value(uint8_t node_id, uint32_t value) {
+    sector_info_t info[2];
+    scan_sector(0, &info[0]);
+    scan_sector(1, &info[1]);
+
+    int current = info[1].max_seq > info[0].max_seq ? 1 : 0;
+    if (info[1 - current].next_free != 0 && !repair(current, info)) {
+        return false;
+    }
+
+    uint32_t seq = info[current].max_seq + 1;
+    if (info[current].next_free >= 0) {
+        return write_record(current, info[current].next_free, node_id, seq, value);
+    }
+
+    // Setor atual cheio: reúne o maior valor de cada nó nos dois setores,
+    // começando pelo valor novo
+    uint8_t ids[COUNTER_STORE_MAX_NODES] = { node_id };
+    uint32_t values[COUNTER_STORE_MAX_NODES] = { value };
+    int count = 1;
+    for (int sector = 0; sector < 2; sector++) {
+        const counter_record_t *records = sector_records(sector);
+        for (int i = 0; i < (int)RECORDS_PER_SECTOR; i++) {
+            if (!record_valid(&records[i])) {
+                continue;
+            }
+            int n = 0;
+            while (n < count && ids[n] != records[i].node_id) {
+                n++;
+            }
+            if (n == count) {
+                // Descartar um nó apagaria seu limite e reabriria o replay:
+                // melhor recusar a gravação e manter o setor como está
+                if (count == COUNTER_STORE_MAX_NODES) {
+                    return false;
+                }
+                ids[count] = records[i].node_id;
+                values[count++] = records[i].value;
+            } else if (records[i].value > values[n]) {
+                values[n] = records[i].value;
+            }
+        }
+    }
+
+    // O outro setor já está apagado (repair). O setor atual só é apagado
+    // depois que a cópia foi gravada.
+    int other = 1 - current;
+    for (int n = 0; n < count; n++) {
+        if (!write_record(other, n, ids[n], seq++, values[n])) {
+            return false;
+        }
+    }
+    erase_sector(current);
+    return true;
+}
+
+bool counter_store_reserve(uint8_t node_id, uint32_t *limit, uint32_t next, uint32_t block) {
+    if (next <= *limit) {
+        return true;
+    }
+
+    uint32_t new_limit = next - 1 + block;
+    if (new_limit < next) {
+        new_limit = UINT32_MAX;
+    }
+    if (!store_value(node_id, new_limit)) {
+        return false;
+    }
+    *limit = new_limit;
+    return true;
+}
@@ -0,0 +1,38 @@
+#ifndef COUNTER_STORE_H
+#define COUNTER_STORE_H
+
+#include <stdbool.h>
+#include <stdint.h>
+#include "../node_config/node_config.h"
+
+// Persistência dos contadores do quadro seguro na flash.
+// Um contador não pode voltar atrás após um reboot: no TX isso repetiria o
+// keystream do AES-CTR, no RX faria quadros antigos serem aceitos de novo.
+// Para poupar a flash, grava-se um limite que cobre um bloco de valores:
+// - TX: reserva SECURE_COUNTER_TX_BLOCK contadores antes de usá-los e, no
+//   boot, continua a partir do limite gravado (os valores não usados do
+//   último bloco são descartados);
+// - RX/gateway: grava um limite acima do último contador aceito de cada nó
+//   e, no boot, rejeita tudo até ele. Após um reboot do receptor, até
+//   SECURE_COUNTER_RX_BLOCK quadros de cada nó são descartados.
+//
+// Os registros formam um log em dois setores logo abaixo do bloco de
+// configuração. Quando um setor enche, o maior valor de cada nó é copiado
+// para o outro setor antes de apagá-lo, de modo que uma queda de energia
+// nunca perde o limite gravado.
+
+#define COUNTER_STORE_FLASH_OFFSET  (NODE_CONFIG_FLASH_OFFSET - 2 * 4096)
+#define COUNTER_STORE_MAX_NODES     16  // Nós distintos no log (acima disso a gravação falha)
+
+#define SECURE_COUNTER_TX_BLOCK     256
+#define SECURE_COUNTER_RX_BLOCK     32
+
+// Último limite gravado para o nó (0 se não houver)
+uint32_t counter_store_load(uint8_t node_id);
+
+// Garante que o limite gravado cubra o contador next. Se não cobrir, grava
+// next - 1 + block e atualiza *limit. Retorna false se a gravação falhar;
+// neste caso o contador não deve ser usado (TX) nem o quadro entregue (RX).
+bool counter_store_reserve(uint8_t node_id, uint32_t *limit, uint32_t next, uint32_t block);
+
+#endif // COUNTER_STORE_H
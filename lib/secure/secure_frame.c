@@ -0,0 +1,121 @@
+#include "secure_frame.h"
+
+static inline void store_le32(uint8_t *p, uint32_t v) {
+    p[0] = (uint8_t)v;
+    p[1] = (uint8_t)(v >> 8);
+    p[2] = (uint8_t)(v >> 16);
+    p[3] = (uint8_t)(v >> 24);
+}
+
+static inline uint32_t load_le32(const uint8_t *p) {
+    return (uint32_t)p[0] | ((uint32_t)p[1] << 8) | ((uint32_t)p[2] << 16) | ((uint32_t)p[3] << 24);
+}
+
+// Bloco inicial do CTR: cabeçalho do quadro (node_id + contador) seguido de
+// zeros; os dois últimos bytes contam os blocos dentro do quadro
+static void ctr_block(const uint8_t *header, uint8_t block[AES128_BLOCK_SIZE]) {
+    for (int i = 0; i < AES128_BLOCK_SIZE; i++) {
+        block[i] = i < SECURE_FRAME_HEADER_LEN ? header[i] : 0;
+    }
+}
+
+// Comparação em tempo constante
+static bool tag_equal(const uint8_t *a, const uint8_t *b, size_t len) {
+    uint8_t diff = 0;
+    for (size_t i = 0; i < len; i++) {
+        diff |= a[i] ^ b[i];
+    }
+    return diff == 0;
+}
+
+void secure_node_init(secure_node_t *node, uint8_t node_id, const uint8_t key[AES128_BLOCK_SIZE],
+                      uint32_t counter) {
+    aes128_ctx_t master;
+    uint8_t block[AES128_BLOCK_SIZE] = { 0 };
+
+    node->node_id = node_id;
+    node->counter = counter;
+
+    aes128_init(&master, key);
+
+    block[0] = 0x01;
+    aes128_encrypt_block(&master, block, block);
+    aes128_init(&node->enc, block);
+
+    for (int i = 0; i < AES128_BLOCK_SIZE; i++) {
+        block[i] = 0;
+    }
+    block[0] = 0x02;
+    aes128_encrypt_block(&master, block, block);
+    aes128_cmac_init(&node->mac, block);
+}
+
+int secure_frame_seal(secure_node_t *node, uint8_t *frame, size_t payload_len, size_t frame_size) {
+    if (payload_len + SECURE_FRAME_OVERHEAD > frame_size) {
+        return SECURE_FRAME_ERR_SIZE;
+    }
+    if (node->counter == UINT32_MAX) {
+        return SECURE_FRAME_ERR_COUNTER;
+    }
+
+    uint8_t *payload = frame + SECURE_FRAME_HEADER_LEN;
+    uint8_t block[AES128_BLOCK_SIZE];
+
+    node->counter++;
+    frame[0] = node->node_id;
+    store_le32(&frame[1], node->counter);
+
+    ctr_block(frame, block);
+    aes128_ctr_xor(&node->enc, block, payload, payload_len);
+
+    // Tag sobre cabeçalho + texto cifrado
+    aes128_cmac(&node->mac, frame, SECURE_FRAME_HEADER_LEN + payload_len, block);
+    for (int i = 0; i < SECURE_FRAME_TAG_LEN; i++) {
+        payload[payload_len + i] = block[i];
+    }
+
+    return (int)(payload_len + SECURE_FRAME_OVERHEAD);
+}
+
+int secure_frame_open(secure_node_t *node, uint8_t *frame, size_t frame_len) {
+    if (frame_len < SECURE_FRAME_OVERHEAD) {
+        return SECURE_FRAME_ERR_SIZE;
+    }
+    if (frame[0] != node->node_id) {
+        return SECURE_FRAME_ERR_NODE;
+    }
+
+    size_t payload_len = frame_len - SECURE_FRAME_OVERHEAD;
+    uint8_t *payload = frame + SECURE_FRAME_HEADER_LEN;
+    uint8_t block[AES128_BLOCK_SIZE];
+
+    // Autentica antes de qualquer outra decisão sobre o conteúdo
+    aes128_cmac(&node->mac, frame, SECURE_FRAME_HEADER_LEN + payload_len, block);
+    if (!tag_equal(block, payload + payload_len, SECURE_FRAME_TAG_LEN)) {
+        return SECURE_FRAME_ERR_AUTH;
+    }
+
+    // O contador de cada quadro aceito deve ser maior que o do anterior
+    uint32_t counter = load_le32(&frame[1]);
+    if (counter <= node->counter) {
+        return SECURE_FRAME_ERR_REPLAY;
+    }
+    node->counter = counter;
+
+    ctr_block(frame, block);
+    aes128_ctr_xor(&node->enc, block, payload, payload_len);
+
+    return (int)payload_len;
+}
+
+secure_node_t *secure_node_find(secure_node_t *nodes, size_t count, const uint8_t *frame, size_t frame_len) {
+    if (frame_len < SECURE_FRAME_OVERHEAD) {
+        return NULL;
+    }
+    for (size_t i = 0; i < count; i++) {
+        if (nodes[i].node_id == frame[0]) {
+            return &nodes[i];
+        }
+    }
+    return NULL;
+}
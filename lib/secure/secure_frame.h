@@ -0,0 +1,57 @@
+#ifndef SECURE_FRAME_H
+#define SECURE_FRAME_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "aes128.h"
+
+// Camada opcional de quadro seguro para a telemetria LoRa.
+// Cifra AES-128-CTR e autentica (encrypt-then-MAC) com AES-CMAC truncado,
+// usando uma chave por nó e um contador anti-replay. Tudo é feito no próprio
+// buffer do quadro, sem alocação:
+//
+//   | node_id (1) | contador (4, LE) | payload cifrado (n) | tag CMAC (8) |
+//
+// As chaves de cifra e de MAC são derivadas da chave do nó:
+//   K_enc = AES_K(0x01 || 0...), K_mac = AES_K(0x02 || 0...)
+
+#define SECURE_FRAME_HEADER_LEN     5
+#define SECURE_FRAME_TAG_LEN        8
+#define SECURE_FRAME_OVERHEAD       (SECURE_FRAME_HEADER_LEN + SECURE_FRAME_TAG_LEN)
+
+// Códigos de erro de secure_frame_open/seal
+#define SECURE_FRAME_ERR_SIZE       -1  // Quadro curto demais ou buffer insuficiente
+#define SECURE_FRAME_ERR_NODE       -2  // node_id não corresponde ao contexto
+#define SECURE_FRAME_ERR_AUTH       -3  // Tag inválida (quadro adulterado ou chave errada)
+#define SECURE_FRAME_ERR_REPLAY     -4  // Contador já visto
+#define SECURE_FRAME_ERR_COUNTER    -5  // Contador de transmissão esgotado
+
+// Contexto de um nó: no TX, counter é o último valor enviado; no RX, o
+// último valor aceito daquele nó. O primeiro quadro leva counter + 1.
+typedef struct {
+    uint8_t node_id;
+    uint32_t counter;
+    aes128_ctx_t enc;
+    aes128_cmac_ctx_t mac;
+} secure_node_t;
+
+// Prepara o contexto do nó a partir da chave de 16 bytes. No firmware, o
+// contador inicial vem da flash (counter_store.h): nunca reiniciar em 0 um
+// nó que já transmitiu ou recebeu com a mesma chave.
+void secure_node_init(secure_node_t *node, uint8_t node_id, const uint8_t key[AES128_BLOCK_SIZE],
+                      uint32_t counter);
+
+// Sela o quadro: o texto claro deve estar em frame + SECURE_FRAME_HEADER_LEN.
+// Retorna o tamanho total do quadro ou um código de erro negativo.
+int secure_frame_seal(secure_node_t *node, uint8_t *frame, size_t payload_len, size_t frame_size);
+
+// Verifica e decifra o quadro no lugar. O texto claro fica em
+// frame + SECURE_FRAME_HEADER_LEN. Retorna o tamanho do payload ou um
+// código de erro negativo.
+int secure_frame_open(secure_node_t *node, uint8_t *frame, size_t frame_len);
+
+// Procura, numa tabela de nós, o contexto correspondente ao node_id do quadro
+secure_node_t *secure_node_find(secure_node_t *nodes, size_t count, const uint8_t *frame, size_t frame_len);
+
+#endif // SECURE_FRAME_H
@@ -0,0 +1,41 @@
+#include "secure_rx.h"
+
+void secure_rx_init(secure_rx_t *rx) {
+    rx->count = 0;
+}
+
+bool secure_rx_add_node(secure_rx_t *rx, uint8_t node_id, const uint8_t key[AES128_BLOCK_SIZE]) {
+    if (rx->count >= SECURE_RX_MAX_NODES) {
+        return false;
+    }
+
+    size_t i = rx->count++;
+    rx->limits[i] = counter_store_load(node_id);
+    secure_node_init(&rx->nodes[i], node_id, key, rx->limits[i]);
+    return true;
+}
+
+int secure_rx_accept(secure_rx_t *rx, uint8_t *frame, size_t frame_len, const secure_node_t **node) {
+    secure_node_t *found = secure_node_find(rx->nodes, rx->count, frame, frame_len);
+    if (found == NULL) {
+        return SECURE_FRAME_ERR_NODE;
+    }
+
+    int payload_len = secure_frame_open(found, frame, frame_len);
+    if (payload_len < 0) {
+        return payload_len;
+    }
+
+    // O quadro só é entregue depois que o contador aceito está na flash
+    if (!counter_store_reserve(found->node_id, &rx->limits[found - rx->nodes],
+                               found->counter, SECURE_COUNTER_RX_BLOCK)) {
+        return SECURE_RX_ERR_STORE;
+    }
+
+    // Sobrescreve o primeiro byte da tag, que já foi verificada
+    frame[SECURE_FRAME_HEADER_LEN + payload_len] = '\0';
+    if (node != NULL) {
+        *node = found;
+    }
+    return payload_len;
+}
@@ -0,0 +1,41 @@
+#ifndef SECURE_RX_H
+#define SECURE_RX_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include "secure_frame.h"
+#include "counter_store.h"
+
+// Recepção de quadros seguros, comum ao receptor e ao gateway.
+// Reúne os contextos dos nós conhecidos e o limite de contador de cada um
+// gravado na flash (counter_store.h), e aplica a sequência completa de
+// aceitação de um quadro.
+
+#define SECURE_RX_MAX_NODES     COUNTER_STORE_MAX_NODES
+
+// Código de erro extra de secure_rx_accept (além dos de secure_frame.h)
+#define SECURE_RX_ERR_STORE     -6  // Falha ao gravar o contador na flash
+
+typedef struct {
+    secure_node_t nodes[SECURE_RX_MAX_NODES];
+    uint32_t limits[SECURE_RX_MAX_NODES];  // Limite gravado na flash por nó
+    size_t count;
+} secure_rx_t;
+
+// Prepara o receptor sem nós
+void secure_rx_init(secure_rx_t *rx);
+
+// Registra um nó. O contador parte do limite gravado na flash, de modo que,
+// após um reboot, nenhum contador possivelmente já aceito o seja de novo.
+// Retorna false se não houver espaço.
+bool secure_rx_add_node(secure_rx_t *rx, uint8_t node_id, const uint8_t key[AES128_BLOCK_SIZE]);
+
+// Identifica o nó, autentica, verifica o contador e decifra o quadro no
+// lugar; o quadro só é aceito depois que o contador está coberto pelo limite
+// gravado na flash. O payload fica em frame + SECURE_FRAME_HEADER_LEN,
+// terminado em '\0'. Retorna o tamanho do payload ou um código de erro
+// negativo; se node não for NULL, recebe o nó do quadro aceito.
+int secure_rx_accept(secure_rx_t *rx, uint8_t *frame, size_t frame_len, const secure_node_t **node);
+
+#endif // SECURE_RX_H
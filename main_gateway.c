@@ -0,0 +1,128 @@
+#include <stdio.h>
+#include <string.h>
+#include "pico/stdlib.h"
+#include "hardware/spi.h"
+#include "hardware/gpio.h"
+#include "lib/lora/lora.h" // Registradores e constantes
+#include "lib/payload/payload.h"
+#include "lib/node_config/node_config.h"
+#if LORA_SECURE_FRAME
+#include "lib/secure/secure_rx.h"
+#include "secure_keys.h"
+
+secure_rx_t secure_rx;
+#endif
+#include "lib/lora/lora_gateway.h"
+
+// Rádio 0: mesmo módulo/pinos do receptor simples (spi0)
+lora_config_t lora_config_0 = {
+    .spi = spi0,
+    .pin_cs = 17,
+    .pin_rst = 20,
+    .pin_sck = 18,
+    .pin_mosi = 19,
+    .pin_miso = 16,
+    .pin_dio0 = 21
+};
+
+// Rádio 1: segundo módulo no spi1
+lora_config_t lora_config_1 = {
+    .spi = spi1,
+    .pin_cs = 13,
+    .pin_rst = 14,
+    .pin_sck = 10,
+    .pin_mosi = 11,
+    .pin_miso = 12,
+    .pin_dio0 = 15
+};
+
+lora_config_t *lora_configs[NODE_CONFIG_MAX_RADIOS] = { &lora_config_0, &lora_config_1 };
+
+lora_gateway_t gateway;
+node_config_t node_config;
+
+int main() {
+    stdio_init_all();
+
+    // Aguarda inicialização da porta serial para garantir que vemos todos os logs
+    sleep_ms(2000);
+
+    printf("Inicializando gateway LoRa...\n");
+
+#if LORA_SECURE_FRAME
+    secure_rx_init(&secure_rx);
+    for (size_t i = 0; i < SECURE_NUM_KEYS; i++) {
+        secure_rx_add_node(&secure_rx, secure_keys[i].node_id, secure_keys[i].key);
+    }
+#endif
+
+    // Cada rádio escuta o canal/SF definido no bloco de configuração
+    bool from_flash = node_config_load(&node_config, NODE_ROLE_GATEWAY);
+    printf("Configuracao %s\n", from_flash ? "da flash" : "padrao");
+
+    lora_gateway_init(&gateway);
+    for (uint8_t i = 0; i < node_config.num_radios; i++) {
+        const node_radio_config_t *radio = &node_config.radio[i];
+        node_config_apply_radio(&node_config, i, lora_configs[i]);
+        if (lora_gateway_add_radio(&gateway, lora_configs[i]) < 0) {
+            printf("Radio %d: sem espaco no gateway, ignorado\n", i);
+            continue;
+        }
+        printf("Radio %d: %lu kHz, SF%d\n", i, radio->frequency_khz, radio->spreading >> 4);
+    }
+    lora_gateway_start(&gateway);
+
+    printf("Gateway com %d radios pronto para receber!\n", gateway.num_radios);
+
+    lora_frame_t frame;
+    float temp_bmp, temp_aht, hum_aht;
+    absolute_time_t next_stats = make_timeout_time_ms(node_config.report_interval_ms);
+
+    while (1) {
+        // Descarrega os rádios sinalizados e processa a fila em ordem de chegada
+        lora_gateway_poll(&gateway);
+
+        while (lora_gateway_pop(&gateway, &frame)) {
+            printf("\n-----------PACOTE RECEBIDO (radio %d)-----------------\n", frame.radio);
+            printf("Instante: %llu us\n", frame.timestamp_us);
+            printf("Comprimento: %d bytes, RSSI: %d dBm, SNR: %d dB\n", frame.len, frame.rssi, frame.snr);
+
+            char *payload = (char*)frame.data;
+#if LORA_SECURE_FRAME
+            const secure_node_t *node;
+            int payload_len = secure_rx_accept(&secure_rx, frame.data, frame.len, &node);
+            if (payload_len < 0) {
+                printf("Quadro rejeitado (erro %d)\n", payload_len);
+                continue;
+            }
+            payload = (char*)frame.data + SECURE_FRAME_HEADER_LEN;
+            printf("No: %d, contador: %lu\n", node->node_id, node->counter);
+#endif
+            printf("Dados: %s\n", payload);
+
+            if (parse_data_string(payload, &temp_bmp, &temp_aht, &hum_aht)) {
+                printf("Temperatura BMP280: %.2f °C\n", temp_bmp);
+                printf("Temperatura AHT20: %.2f °C\n", temp_aht);
+                printf("Umidade AHT20: %.2f %%\n", hum_aht);
+            } else {
+                printf("Erro ao decodificar os dados recebidos!\n");
+            }
+        }
+
+        if (time_reached(next_stats)) {
+            printf("\n-----------ESTATISTICAS-----------------\n");
+            for (uint8_t i = 0; i < gateway.num_radios; i++) {
+                const lora_radio_stats_t *stats = lora_gateway_stats(&gateway, i);
+                printf("Radio %d: ok=%lu crc=%lu trunc=%lu perdidos=%lu ultimo RSSI=%d dBm\n",
+                       i, stats->rx_ok, stats->crc_errors, stats->truncated,
+                       stats->dropped, stats->last_rssi);
+            }
+            next_stats = make_timeout_time_ms(node_config.report_interval_ms);
+        }
+
+        // A chegada dos pacotes é registrada pela IRQ do DIO0; o laço só descarrega
+        sleep_ms(1);
+    }
+
+    return 0;
+}
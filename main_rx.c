@@ -4,6 +4,14 @@
 #include "hardware/spi.h"
 #include "hardware/gpio.h"
 #include "lib/lora/lora.h" // Registradores e constantes
+#include "lib/payload/payload.h"
+#include "lib/node_config/node_config.h"
+#if LORA_SECURE_FRAME
+#include "lib/secure/secure_rx.h"
+#include "secure_keys.h"
+
+secure_rx_t secure_rx;
+#endif
 
 lora_config_t lora_config = {
     .spi = spi0,
@@ -14,13 +22,6 @@ lora_config_t lora_config = {
     .pin_miso = 16   // GPIO4 para MISO
 };
 
-// Função para extrair valores da string
-bool parse_data_string(const char* data, float* temp_bmp, float* temp_aht, float* hum_aht) {
-    // Formato esperado: "T1:XX.XX,T2:XX.XX,H:XX.XX"
-    int result = sscanf(data, "T1:%f,T2:%f,H:%f", temp_bmp, temp_aht, hum_aht);
-    return (result == 3); // Retorna true se conseguiu extrair os 3 valores
-}
-
 int main() {
     stdio_init_all();
 
@@ -29,13 +30,27 @@ int main() {
 
     printf("Inicializando receptor LoRa...\n");
 
+    // Parâmetros de rádio vêm do bloco de configuração (ou dos valores padrão)
+    node_config_t node_config;
+    bool from_flash = node_config_load(&node_config, NODE_ROLE_RX);
+    node_config_apply_radio(&node_config, 0, &lora_config);
+    printf("Configuracao %s: %lu kHz, SF%d\n", from_flash ? "da flash" : "padrao",
+           node_config.radio[0].frequency_khz, node_config.radio[0].spreading >> 4);
+
     lora_setup(&lora_config); // Executa toda a configuração inicial
     printf("Receptor LoRa configurado e pronto para receber!\n");
 
+#if LORA_SECURE_FRAME
+    secure_rx_init(&secure_rx);
+    for (size_t i = 0; i < SECURE_NUM_KEYS; i++) {
+        secure_rx_add_node(&secure_rx, secure_keys[i].node_id, secure_keys[i].key);
+    }
+#endif
+
     // Configurar para modo de recepção contínua
     lora_receive_continuous(&lora_config);
 
-    uint8_t buffer[65]; // 64 bytes + 1 para null terminator
+    uint8_t buffer[PAYLOAD_LENGTH + 1]; // Maior pacote possível + 1 para null terminator
     uint8_t len = 0;
     float temp_bmp, temp_aht, hum_aht;
 
@@ -44,10 +59,24 @@ int main() {
         if (lora_receive_packet(&lora_config, buffer, &len)) {
             printf("\n-----------PACOTE RECEBIDO-----------------\n");
             printf("Comprimento: %d bytes\n", len);
-            printf("Dados: %s\n", buffer);
+
+            char *payload = (char*)buffer;
+#if LORA_SECURE_FRAME
+            // Autentica, verifica o contador e decifra no próprio buffer
+            const secure_node_t *node;
+            int payload_len = secure_rx_accept(&secure_rx, buffer, len, &node);
+            if (payload_len < 0) {
+                printf("Quadro rejeitado (erro %d)\n", payload_len);
+                lora_receive_continuous(&lora_config);
+                continue;
+            }
+            payload = (char*)buffer + SECURE_FRAME_HEADER_LEN;
+            printf("No: %d, contador: %lu\n", node->node_id, node->counter);
+#endif
+            printf("Dados: %s\n", payload);
 
             // Processa os dados recebidos
-            if (parse_data_string((char*)buffer, &temp_bmp, &temp_aht, &hum_aht)) {
+            if (parse_data_string(payload, &temp_bmp, &temp_aht, &hum_aht)) {
                 printf("-----------DADOS DECODIFICADOS-----------------\n");
                 printf("Temperatura BMP280: %.2f °C\n", temp_bmp);
                 printf("Temperatura AHT20: %.2f °C\n", temp_aht);
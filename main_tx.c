@@ -7,6 +7,15 @@
 #include "hardware/i2c.h"
 #include "lib/aht20/aht20.h"
 #include "lib/bmp280/bmp280.h"
+#include "lib/i2c_async/i2c_async.h"
+#include "lib/payload/payload.h"
+#include "lib/node_config/node_config.h"
+#if LORA_SECURE_FRAME
+#include "hardware/clocks.h"
+#include "lib/secure/counter_store.h"
+#include "lib/secure/secure_frame.h"
+#include "secure_keys.h"
+#endif
 
 #define I2C_PORT_0_BPM280 i2c0         // i2c0 pinos 0 e 1
 #define I2C_SDA_0 0                   // 0
@@ -25,8 +34,74 @@ lora_config_t lora_config = {
     .pin_miso = 16   // GPIO4 para MISO
 };
 
+#if LORA_SECURE_FRAME
+secure_node_t secure_node;
+uint32_t counter_limit; // Maior contador já reservado na flash
+
+// Mede o custo da selagem em ciclos por byte (payload típico de 25 bytes)
+static void secure_frame_self_bench(void) {
+    secure_node_t node;
+    uint8_t frame[64] = { 0 };
+    const int runs = 100;
+    const int len = 25;
+
+    secure_node_init(&node, 0, secure_keys[0].key, 0);
+    uint64_t start = time_us_64();
+    for (int i = 0; i < runs; i++) {
+        secure_frame_seal(&node, frame, len, sizeof(frame));
+    }
+    uint64_t elapsed = time_us_64() - start;
+
+    float cycles_per_byte = (float)elapsed * (clock_get_hz(clk_sys) / 1e6f) / (runs * len);
+    printf("Quadro seguro: %.1f us por quadro, %.1f ciclos/byte\n",
+           (float)elapsed / runs, cycles_per_byte);
+}
+#endif
+
+node_config_t node_config;
+
+// Ciclo de leitura dos sensores, conduzido por callbacks e por um alarme:
+// disparo do AHT20 -> alarme de AHT20_MEASURE_TIME_MS -> leitura do AHT20 e
+// do BMP280 ao mesmo tempo, cada uma em seu barramento
+static aht20_async_t aht_ctx;
+static bmp280_async_t bmp_ctx;
+static volatile bool aht_triggered = false;  // AHT20 aceitou o comando de medição
+static volatile bool sensor_error = false;   // Não foi possível agendar as leituras
+static volatile uint8_t reads_pending = 0;   // Leituras ainda não concluídas
+
+// Fim de uma das leituras de dados (contexto de interrupção)
+static void sensor_read_done(i2c_async_xfer_t *xfer, void *user_data) {
+    reads_pending--;
+}
+
+// Alarme do fim da medição: inicia as duas leituras em paralelo. Uma leitura
+// que não pôde ser iniciada fica marcada como falha no próprio descritor.
+static int64_t sensor_measure_ready(alarm_id_t id, void *user_data) {
+    if (!aht_triggered || !aht20_fetch_start(I2C_PORT_1_AHT20, &aht_ctx, sensor_read_done, NULL)) {
+        reads_pending--;
+    }
+    if (!bmp280_read_raw_start(I2C_PORT_0_BPM280, &bmp_ctx, sensor_read_done, NULL)) {
+        reads_pending--;
+    }
+    return 0; // Não repete o alarme
+}
+
+// Fim do comando de medição do AHT20: a contagem do tempo de conversão
+// começa aqui, sem bloquear a CPU
+static void sensor_trigger_done(i2c_async_xfer_t *xfer, void *user_data) {
+    aht_triggered = xfer->ok;
+    if (add_alarm_in_ms(AHT20_MEASURE_TIME_MS, sensor_measure_ready, NULL, true) < 0) {
+        sensor_error = true;
+        reads_pending = 0;
+    }
+}
+
 int main() {
     stdio_init_all();
+
+    // Papel, identificador, rádio e intervalo vêm do bloco de configuração
+    bool from_flash = node_config_load(&node_config, NODE_ROLE_TX);
+    node_config_apply_radio(&node_config, 0, &lora_config);
     lora_setup(&lora_config); // Executa toda a configuração inicial
 
     // Inicializa o I2C_0 para aht20
@@ -43,32 +118,88 @@ int main() {
     gpio_pull_up(I2C_SDA_1);
     gpio_pull_up(I2C_SCL_1);
 
+    // Habilita as transações assíncronas (DMA) nos dois barramentos
+    i2c_async_init(I2C_PORT_0_BPM280);
+    i2c_async_init(I2C_PORT_1_AHT20);
+
     // Inicializa o BMP280
     bmp280_init(I2C_PORT_0_BPM280);
-    struct bmp280_calib_param params;
-    bmp280_get_calib_params(I2C_PORT_0_BPM280, &params);
+    struct bmp280_calib_param params = { 0 };
+    bool calib_started = bmp280_get_calib_params_start(I2C_PORT_0_BPM280, &bmp_ctx, NULL, NULL);
 
-    // Inicializa o AHT20
+    // Inicializa o AHT20 enquanto a calibração do BMP280 é lida pelo DMA
     aht20_reset(I2C_PORT_1_AHT20);
     aht20_init(I2C_PORT_1_AHT20);
+    if (!calib_started || !bmp280_get_calib_params_finish(&bmp_ctx, &params)) {
+        // Nova tentativa, agora síncrona; sem calibração a pressão sai 0
+        if (!bmp280_get_calib_params(I2C_PORT_0_BPM280, &params)) {
+            printf("Erro ao ler a calibracao do BMP280\n");
+        }
+    }
 
     // Estrutura para armazenar os dados do sensor
     AHT20_Data data;
-    int32_t raw_temp_bmp;
-    int32_t raw_pressure;
+    int32_t raw_temp_bmp = 0;
+    int32_t raw_pressure = 0;
+
+#if LORA_SECURE_FRAME
+    // O contador continua acima do último bloco reservado antes do reboot
+    counter_limit = counter_store_load(node_config.node_id);
+    bool key_found = false;
+    for (size_t i = 0; i < SECURE_NUM_KEYS; i++) {
+        if (secure_keys[i].node_id == node_config.node_id) {
+            secure_node_init(&secure_node, node_config.node_id, secure_keys[i].key, counter_limit);
+            key_found = true;
+        }
+    }
+    // Sem chave para este nó não há como transmitir com segurança
+    while (!key_found) {
+        printf("Nenhuma chave em secure_keys.h para o no %d\n", node_config.node_id);
+        sleep_ms(5000);
+    }
+#endif
 
     sleep_ms(2000); // Aguarda 1 segundo para estabilizar
+#if LORA_SECURE_FRAME
+    secure_frame_self_bench();
+#endif
+    printf("Configuracao %s: no %d, %lu kHz, SF%d, intervalo %lu ms\n",
+           from_flash ? "da flash" : "padrao", node_config.node_id,
+           node_config.radio[0].frequency_khz, node_config.radio[0].spreading >> 4,
+           node_config.sample_interval_ms);
     printf("Transmissor LoRa pronto para enviar dados.\n");
     sleep_ms(5000); // Aguarda 2 segundos antes de iniciar a transmissão
 
     while (1) {
+        i2c_async_reset_stats();
 
-        // Leitura do BMP280
-        bmp280_read_raw(I2C_PORT_0_BPM280, &raw_temp_bmp, &raw_pressure);
-        int32_t temperature = bmp280_convert_temp(raw_temp_bmp, &params);
-        int32_t pressure = bmp280_convert_pressure(raw_pressure, raw_temp_bmp, &params);
+        // Dispara a medição do AHT20; o restante do ciclo segue pelos callbacks
+        sensor_error = false;
+        reads_pending = 2;
+        if (!aht20_trigger_start(I2C_PORT_1_AHT20, &aht_ctx, sensor_trigger_done, NULL)) {
+            printf("Erro ao disparar a medicao do AHT20\n");
+            sleep_ms(node_config.sample_interval_ms);
+            continue;
+        }
 
-        float temp_bmp = temperature / 100.0f; // Temperatura em graus Celsius
+        // CPU livre enquanto o AHT20 mede e as duas leituras correm via DMA
+        while (reads_pending > 0) {
+            tight_loop_contents();
+        }
+        if (sensor_error) {
+            printf("Erro ao agendar a leitura dos sensores\n");
+            sleep_ms(node_config.sample_interval_ms);
+            continue;
+        }
+
+        // Compensação do BMP280
+        float temp_bmp = 0.0f; // Temperatura em graus Celsius
+        int32_t pressure = 0;
+        if (bmp280_read_raw_finish(&bmp_ctx, &raw_temp_bmp, &raw_pressure)) {
+            int32_t temperature = bmp280_convert_temp(raw_temp_bmp, &params);
+            pressure = bmp280_convert_pressure(raw_pressure, raw_temp_bmp, &params);
+            temp_bmp = temperature / 100.0f;
+        }
 
         /* // PRINTS PARA DEPURAÇÃO NO TERMINAL//////////////////////////
         printf("-----------BMP280 LEITURAS-----------------\n");
@@ -79,7 +210,7 @@ int main() {
         float temp_aht = 0.0f;
         float hum_aht = 0.0f;
 
-        if (aht20_read(I2C_PORT_1_AHT20, &data)){
+        if (aht20_fetch_finish(&aht_ctx, &data)){
             temp_aht = data.temperature;
             hum_aht = data.humidity;
             /* printf("----------AHT LEITURAS------------------\n");
@@ -87,18 +218,50 @@ int main() {
             printf("Umidade: %.2f %%\n\n\n", hum_aht); */
         }
 
-        // Formata os dados como string
-        char payload[64]; // Buffer para a string
-        int payload_len = sprintf(payload, "T1:%.2f,T2:%.2f,H:%.2f",
-                               temp_bmp, temp_aht, hum_aht);
+        // Formata os dados como string. Com o quadro seguro, o texto é escrito
+        // já na posição do payload e cifrado no próprio buffer.
+        uint8_t frame[64];
+#if LORA_SECURE_FRAME
+        char *payload = (char*)frame + SECURE_FRAME_HEADER_LEN;
+        int payload_len = format_data_string(payload, sizeof(frame) - SECURE_FRAME_OVERHEAD,
+                                             temp_bmp, temp_aht, hum_aht);
+#else
+        char *payload = (char*)frame;
+        int payload_len = format_data_string(payload, sizeof(frame),
+                                             temp_bmp, temp_aht, hum_aht);
+#endif
 
         // Imprime a string que será enviada (para depuração)
         printf("Enviando: %s\n", payload);
 
-        // Envia a string como um pacote LoRa
-        lora_send_packet(&lora_config, (uint8_t*)payload, payload_len);
+        // Ocupação dos barramentos I2C neste ciclo
+        i2c_async_stats_t stats;
+        i2c_async_get_stats(&stats);
+        printf("I2C: i2c0 %llu us, i2c1 %llu us, sobreposicao %llu us\n",
+               stats.busy_us[0], stats.busy_us[1], stats.overlap_us);
+
+#if LORA_SECURE_FRAME
+        // O contador só é usado depois de coberto pelo limite gravado na flash
+        if (!counter_store_reserve(secure_node.node_id, &counter_limit, secure_node.counter + 1,
+                                   SECURE_COUNTER_TX_BLOCK)) {
+            printf("Erro ao gravar o contador na flash\n");
+            sleep_ms(node_config.sample_interval_ms);
+            continue;
+        }
+        int frame_len = secure_frame_seal(&secure_node, frame, payload_len, sizeof(frame));
+        if (frame_len < 0) {
+            printf("Erro ao selar o quadro (%d)\n", frame_len);
+            sleep_ms(node_config.sample_interval_ms);
+            continue;
+        }
+#else
+        int frame_len = payload_len;
+#endif
+
+        // Envia o quadro como um pacote LoRa
+        lora_send_packet(&lora_config, frame, frame_len);
 
-        sleep_ms(2000); // Aguarda 2 segundos antes de enviar o próximo pacote
+        sleep_ms(node_config.sample_interval_ms); // Aguarda o intervalo configurado antes do próximo pacote
     }
 
     return 0;
@@ -0,0 +1,30 @@
+// secure_keys.h
+/* Chaves dos nós para o quadro seguro (lib/secure/secure_frame.h).
+ * ATENÇÃO: chaves de exemplo. Gere chaves próprias (16 bytes aleatórios
+ * por nó) antes de instalar os nós em campo.
+ */
+
+#ifndef SECURE_KEYS_H
+#define SECURE_KEYS_H
+
+#include <stdint.h>
+#include "lib/secure/secure_rx.h"
+
+typedef struct {
+    uint8_t node_id;
+    uint8_t key[16];
+} secure_key_entry_t;
+
+// Tabela de nós. O transmissor usa a chave do node_id do seu bloco de
+// configuração; o receptor/gateway aceita quadros de todos os nós listados.
+static const secure_key_entry_t secure_keys[] = {
+    { 1, { 0x3a, 0x91, 0x5c, 0x07, 0xe2, 0x48, 0xbd, 0x16, 0x7f, 0xc4, 0x29, 0x83, 0xd0, 0x5e, 0xa1, 0x6b } },
+    { 2, { 0xc8, 0x24, 0x7e, 0xf1, 0x0b, 0x96, 0x53, 0xda, 0x35, 0x6c, 0xe9, 0x12, 0xa7, 0x4f, 0x80, 0xbe } },
+};
+
+#define SECURE_NUM_KEYS (sizeof(secure_keys) / sizeof(secure_keys[0]))
+
+// Cada nó precisa de um registro próprio no log de contadores da flash
+_Static_assert(SECURE_NUM_KEYS <= SECURE_RX_MAX_NODES, "nós demais para o log de contadores");
+
+#endif
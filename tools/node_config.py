@@ -0,0 +1,120 @@
+#!/usr/bin/env python3
+"""Gera o bloco de configuração binário (lib/node_config/node_config.h).
+
+Exemplo - transmissor no 3, 915 MHz, SF9, 125 kHz, CR 4/5, leitura a cada 5 s:
+
+    python3 tools/node_config.py --role tx --node-id 3 \\
+        --radio 915000,9,125,5 --sample-interval 5000 -o tx3.bin
+    picotool load -t bin tx3.bin -o 0x101FF000
+
+O endereço de gravação é o último setor de 4 KB da flash (0x101FF000 para
+os 2 MB do Pico W); use --flash-size para outras placas.
+"""
+
+import argparse
+import struct
+import sys
+import zlib
+
+MAGIC = 0x46434E4C  # "LNCF"
+VERSION = 1
+MAX_RADIOS = 2
+XIP_BASE = 0x10000000
+SECTOR_SIZE = 4096
+
+ROLES = {"tx": 1, "rx": 2, "gateway": 3}
+
+BANDWIDTHS = {
+    "7.8": 0x00, "10.4": 0x10, "15.6": 0x20, "20.8": 0x30, "31.25": 0x40,
+    "41.7": 0x50, "62.5": 0x60, "125": 0x70, "250": 0x80, "500": 0x90,
+}
+
+CODING_RATES = {5: 0x02, 6: 0x04, 7: 0x06, 8: 0x08}
+
+PA_MAX_BOOST = 0x8F
+
+
+def parse_radio(text):
+    """freq_khz,sf[,bw_khz[,cr[,pa_config]]] -> (freq, spreading, modem_config, tx_power)"""
+    fields = text.split(",")
+    if not 2 <= len(fields) <= 5:
+        raise argparse.ArgumentTypeError("formato: freq_khz,sf[,bw_khz[,cr[,pa_config]]]")
+
+    freq = int(fields[0])
+    sf = int(fields[1])
+    bw = fields[2] if len(fields) > 2 else "125"
+    cr = int(fields[3]) if len(fields) > 3 else 5
+    power = int(fields[4], 0) if len(fields) > 4 else PA_MAX_BOOST
+
+    if not 137000 <= freq <= 1020000:
+        raise argparse.ArgumentTypeError("frequência fora de 137000..1020000 kHz")
+    # SF6 exige cabeçalho implícito e ajustes de detecção que lora_setup não faz
+    if not 7 <= sf <= 12:
+        raise argparse.ArgumentTypeError("SF deve estar entre 7 e 12")
+    if bw not in BANDWIDTHS:
+        raise argparse.ArgumentTypeError("largura de banda inválida: " + ", ".join(BANDWIDTHS))
+    if cr not in CODING_RATES:
+        raise argparse.ArgumentTypeError("coding rate deve ser 5, 6, 7 ou 8 (4/x)")
+    if not 1 <= power <= 0xFF:
+        raise argparse.ArgumentTypeError("pa_config deve estar entre 0x01 e 0xFF")
+
+    return freq, sf << 4, BANDWIDTHS[bw] | CODING_RATES[cr], power
+
+
+def radio_valid(freq, spreading, modem_config, power, reserved):
+    """Mesmas regras de radio_valid() em lib/node_config/node_config.c"""
+    bandwidth = modem_config & 0xF0
+    coding = modem_config & 0x0E
+    return (137000 <= freq <= 1020000 and
+            0x70 <= spreading <= 0xC0 and spreading & 0x0F == 0 and
+            bandwidth <= 0x90 and
+            0x02 <= coding <= 0x08 and
+            modem_config & 0x01 == 0 and  # ImplicitHeaderModeOn: não suportado
+            power != 0 and
+            reserved == 0)
+
+
+def build(role, node_id, radios, sample_interval, report_interval):
+    padded = list(radios) + [radios[-1]] * (MAX_RADIOS - len(radios))
+    body = struct.pack("<IBBBB", MAGIC, VERSION, ROLES[role], node_id, len(radios))
+    for freq, spreading, modem_config, power in padded:
+        if not radio_valid(freq, spreading, modem_config, power, 0):
+            raise ValueError("rádio inválido: %d kHz, 0x%02X, 0x%02X" % (freq, spreading, modem_config))
+        body += struct.pack("<IBBBB", freq, spreading, modem_config, power, 0)
+    body += struct.pack("<II", sample_interval, report_interval)
+    return body + struct.pack("<I", zlib.crc32(body) & 0xFFFFFFFF)
+
+
+def main():
+    parser = argparse.ArgumentParser(description=__doc__,
+                                     formatter_class=argparse.RawDescriptionHelpFormatter)
+    parser.add_argument("--role", choices=ROLES, required=True)
+    parser.add_argument("--node-id", type=int, default=1)
+    parser.add_argument("--radio", type=parse_radio, action="append",
+                        help="freq_khz,sf[,bw_khz[,cr[,pa_config]]] (repita para o gateway)")
+    parser.add_argument("--sample-interval", type=int, default=2000, help="ms (TX)")
+    parser.add_argument("--report-interval", type=int, default=10000, help="ms (RX/gateway)")
+    parser.add_argument("--flash-size", type=lambda v: int(v, 0), default=2 * 1024 * 1024)
+    parser.add_argument("-o", "--output", required=True)
+    args = parser.parse_args()
+
+    radios = args.radio or [parse_radio("915000,7")]
+    if len(radios) > MAX_RADIOS:
+        parser.error("no máximo %d rádios" % MAX_RADIOS)
+    if not 0 <= args.node_id <= 255:
+        parser.error("node-id deve estar entre 0 e 255")
+    if args.sample_interval < 100 or args.report_interval < 100:
+        parser.error("intervalos devem ser de pelo menos 100 ms")
+
+    block = build(args.role, args.node_id, radios, args.sample_interval, args.report_interval)
+    with open(args.output, "wb") as f:
+        f.write(block)
+
+    address = XIP_BASE + args.flash_size - SECTOR_SIZE
+    print("%s: %d bytes. Grave com: picotool load -t bin %s -o 0x%08X"
+          % (args.output, len(block), args.output, address))
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())